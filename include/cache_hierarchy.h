@@ -0,0 +1,86 @@
+#ifndef CACHE_HIERARCHY_H
+#define CACHE_HIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How a level's contents relate to the levels closer to the core
+enum class CacheInclusion {
+    NON_INCLUSIVE,  // Filled on every miss, no back-invalidation
+    INCLUSIVE,      // Superset of inner levels; evictions back-invalidate them
+    EXCLUSIVE       // Victim cache: filled only by inner-level evictions
+};
+
+struct CacheLevelConfig {
+    std::string name;
+    uint64_t size;              // Bytes
+    uint32_t associativity;
+    uint32_t line_size;         // Bytes, power of two
+    bool write_back;            // false = write-through, no write-allocate
+    CacheInclusion inclusion;   // Ignored for the first level
+};
+
+// One trace record or one request leaving the hierarchy for main memory
+struct CacheRequest {
+    uint64_t address;
+    char operation;             // 'R' or 'W'
+};
+
+struct CacheLevelStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t writebacks;        // Dirty lines pushed to the next level
+    uint64_t back_invalidations;
+};
+
+// On-chip cache filter in front of the memory model (L1 -> L2 -> LLC).
+// Only last-level misses, write-throughs and writebacks reach main memory.
+// Each level keeps its tags in one flat array, one 64-bit word per way
+// (line address << 2 | dirty | valid) with ways in MRU-to-LRU order, so a
+// set lookup touches a single contiguous run of words.
+class CacheHierarchy {
+public:
+    explicit CacheHierarchy(const std::vector<CacheLevelConfig>& level_configs);
+
+    // Filters a batch of core accesses; memory-bound requests are appended to `out`
+    void accessBatch(const CacheRequest* requests, size_t count, std::vector<CacheRequest>& out);
+    void reset();
+    void resetStats();          // Zero the counters, keep cache contents
+
+    size_t memoryBytes() const;
+    void printSummary() const;
+    void printStats() const;
+
+private:
+    static constexpr uint64_t VALID = 1;
+    static constexpr uint64_t DIRTY = 2;
+
+    struct Level {
+        CacheLevelConfig config;
+        uint32_t sets;
+        uint32_t ways;
+        uint32_t line_shift;
+        std::vector<uint64_t> tags;     // sets x ways
+        CacheLevelStats stats;
+
+        uint64_t* set(uint64_t line) { return &tags[(line % sets) * ways]; }
+        int find(const uint64_t* entries, uint64_t line) const;
+        void promote(uint64_t* entries, int way) const;
+        void remove(uint64_t* entries, int way) const;
+    };
+
+    bool access(size_t index, char operation, uint64_t address);
+    void install(size_t index, uint64_t line, bool dirty);
+    bool backInvalidate(size_t index, uint64_t address, uint32_t bytes);
+
+    std::vector<Level> levels;
+    std::vector<CacheRequest>* output;
+
+    uint64_t core_accesses;
+    uint64_t memory_reads;
+    uint64_t memory_writes;
+};
+
+#endif // CACHE_HIERARCHY_H
@@ -0,0 +1,73 @@
+#ifndef COMPRESSED_DRAM_H
+#define COMPRESSED_DRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Compressed DRAM tier for the hybrid (DRAM-as-cache) model.
+// Cached pages are stored compressed and packed into a fixed byte capacity;
+// when a new page does not fit, least-recently-used pages are dropped.
+// Each page's compressed size comes from a trace annotation when one was
+// seen, otherwise from a size-class mix (`mix[i]` is the fraction of pages
+// that compress to (i + 1) / mix.size() of a page). A shadow pool of the same
+// capacity holding the same pages uncompressed measures what compression buys.
+class CompressedDRAM {
+public:
+    CompressedDRAM(uint64_t capacity_bytes, uint32_t page_size, const std::vector<double>& mix,
+                   uint32_t compress_latency, uint32_t decompress_latency);
+
+    bool contains(uint64_t page) const;
+    // False if the page's compressed size exceeds the whole tier (nothing changes then).
+    // Sets the compression latency; pages dropped to make room are listed in `dropped`.
+    bool insert(uint64_t page, uint32_t& latency, std::vector<uint64_t>& dropped);
+    void evict(uint64_t page);
+    uint32_t hit(uint64_t page, bool write); // Returns the (de)compression latency
+    void observe(uint64_t page);            // Compare one lookup against the shadow pool
+    void annotate(uint64_t page, double ratio);
+    void reset();
+    void resetStats();                      // Zero the counters, keep resident pages
+
+    uint32_t compressedSize(uint64_t page) const;
+    void printSummary() const;
+    void printStats() const;
+
+private:
+    // Byte-capacity LRU pool of pages
+    struct Pool {
+        uint64_t capacity;
+        uint64_t used;
+        std::list<uint64_t> lru;    // Most recent at the front
+        std::unordered_map<uint64_t, std::pair<uint32_t, std::list<uint64_t>::iterator>> pages;  // Page -> (bytes, LRU slot)
+
+        bool contains(uint64_t page) const { return pages.count(page) != 0; }
+        void touch(uint64_t page);
+        uint64_t insert(uint64_t page, uint32_t bytes, std::vector<uint64_t>* victims = nullptr);  // Returns pages evicted to make room
+        void erase(uint64_t page);
+        void clear();
+    };
+
+    uint64_t capacity;
+    uint32_t page_size;
+    std::vector<double> cumulative_mix;     // Running sum of the size-class fractions
+    uint32_t compress_latency;
+    uint32_t decompress_latency;
+
+    Pool compressed;
+    Pool shadow;                            // Same pages, stored uncompressed
+    std::unordered_map<uint64_t, uint32_t> annotated_size;  // Page -> size from the trace
+
+    uint64_t insertions;
+    uint64_t capacity_evictions;
+    uint64_t oversize_rejections;       // Promotions refused because the page can never fit
+    uint64_t decompressions;
+    uint64_t recompressions;
+    uint64_t hits_gained;                   // Resident here, would miss uncompressed
+    uint64_t hits_lost;                     // Missing here, would hit uncompressed
+    uint64_t peak_logical_bytes;            // Most uncompressed bytes held at once
+    uint64_t codec_cycles;                  // Compression + decompression latency charged
+};
+
+#endif // COMPRESSED_DRAM_H
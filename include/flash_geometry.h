@@ -0,0 +1,85 @@
+#ifndef FLASH_GEOMETRY_H
+#define FLASH_GEOMETRY_H
+
+#include <cstdint>
+#include <vector>
+
+struct FlashGeometryConfig {
+    bool enabled;               // false = fixed FLASH_READ/WRITE_LATENCY per access
+    uint32_t channels;
+    uint32_t dies_per_channel;
+    uint32_t planes_per_die;
+    uint32_t pages_per_block;
+    uint32_t read_time;         // tR: array read into the page register (cycles)
+    uint32_t program_time;      // tPROG: page register programmed into the array (cycles)
+    uint32_t channel_bandwidth; // Bytes per cycle on each channel bus
+    uint32_t multiplane_window; // Cycles after an op starts during which other planes may join it
+    bool read_suspend;          // Reads may suspend an in-flight program
+    uint32_t suspend_latency;   // Cycles to suspend (and later resume) a program
+    uint32_t max_suspends;      // Reads that may suspend one program
+};
+
+// Physical location of a logical flash page
+struct FlashAddress {
+    uint32_t channel;
+    uint32_t die;               // Die within the channel
+    uint32_t plane;
+    uint64_t block;             // Block within the plane
+    uint32_t page;              // Page within the block
+};
+
+// Channel/die/plane timing model. Logical pages are striped channel first,
+// then die, then plane, so sequential pages spread across the whole device.
+// Each die has its own busy-until timeline and each channel bus is shared
+// by the dies behind it. Reads return the cycle their data has crossed the
+// channel; programs are acknowledged once the data is latched in the die's
+// page register and finish in the background.
+class FlashGeometry {
+public:
+    FlashGeometry(const FlashGeometryConfig& config, uint32_t page_size);
+
+    FlashAddress map(uint64_t page) const;
+    uint64_t read(uint64_t page, uint64_t now);
+    uint64_t program(uint64_t page, uint64_t now);
+    void reset();
+    void resetStats();          // Zero the counters, keep die and channel timelines
+    void printSummary(uint64_t total_pages) const;
+    void printStats(uint64_t elapsed_cycles) const;
+
+private:
+    enum class DieOp { IDLE, READ, PROGRAM };
+
+    struct Die {
+        DieOp op;
+        uint64_t op_start;
+        uint64_t busy_until;        // End of the current array operation
+        uint64_t suspend_until;     // End of the last read serviced inside a suspended program
+        uint32_t plane_mask;        // Planes participating in the current operation
+        uint32_t suspends;          // Times the current program has been suspended
+        uint64_t busy_cycles;       // For utilization
+    };
+
+    struct Channel {
+        uint64_t busy_until;
+        uint64_t busy_cycles;
+    };
+
+    Die& dieFor(const FlashAddress& location);
+    bool canJoin(const Die& die, DieOp op, uint32_t plane, uint64_t now) const;
+    uint64_t transfer(Channel& channel, uint64_t ready);
+
+    FlashGeometryConfig config;
+    uint32_t transfer_cycles;       // One page over a channel bus
+    std::vector<Die> dies;
+    std::vector<Channel> channels;
+
+    // Statistics
+    uint64_t array_reads;
+    uint64_t array_programs;
+    uint64_t multiplane_joins;      // Ops merged into an in-flight multi-plane operation
+    uint64_t read_suspends;
+    uint64_t die_wait_cycles;       // Requests waiting for a busy die
+    uint64_t channel_wait_cycles;   // Requests waiting for a busy channel bus
+};
+
+#endif // FLASH_GEOMETRY_H
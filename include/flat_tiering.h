@@ -0,0 +1,68 @@
+#ifndef FLAT_TIERING_H
+#define FLAT_TIERING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Page placement for flat (non-cache) DRAM+flash tiering.
+// Every page lives in exactly one tier. New pages land in DRAM while it has
+// free frames, otherwise in flash. At each epoch end the pages are ranked by
+// a decaying access score and the hottest flash pages (score at least
+// `promote_threshold`) are exchanged with the coldest DRAM pages, limited by a
+// per-epoch page budget. A promotion must beat its demotion victim by the
+// hysteresis margin, and a migrated page stays put for `cooldown` epochs, so
+// pages near the boundary do not ping-pong.
+class FlatTiering {
+public:
+    FlatTiering(uint64_t dram_pages, uint32_t promote_threshold, uint32_t budget, double hysteresis, uint32_t cooldown);
+
+    // Records a demand access; returns true if the page is in DRAM
+    bool access(uint64_t page);
+    // Ranks pages and moves placement; the pages to copy are returned to the caller
+    void endEpoch(std::vector<uint64_t>& promote, std::vector<uint64_t>& demote);
+    void reset();
+    void resetStats();          // Zero the counters, keep placement and scores
+
+    uint64_t residentPages() const { return dram_resident; }
+    uint64_t capacityPages() const { return dram_pages; }
+    void printSummary() const;
+    void printStats() const;
+
+private:
+    static constexpr uint32_t NEVER_MOVED = UINT32_MAX;
+    static constexpr uint32_t PING_PONG_WINDOW = 4;    // Epochs within which a reversal counts
+
+    struct PageState {
+        uint32_t epoch_accesses;
+        float score;            // Accesses, halved every epoch
+        uint32_t last_move;     // Epoch of the last migration
+        bool in_dram;
+        bool last_move_up;
+    };
+
+    bool eligible(const PageState& state) const;
+    void move(PageState& state, bool to_dram);
+
+    uint64_t dram_pages;
+    uint32_t promote_threshold;
+    uint32_t budget;            // Page migrations per epoch (0 = unlimited)
+    double hysteresis;
+    uint32_t cooldown;
+
+    std::unordered_map<uint64_t, PageState> pages;
+    uint64_t dram_resident;
+    uint32_t epoch;
+
+    // Statistics
+    uint64_t epochs;
+    uint64_t promotions;
+    uint64_t demotions;
+    uint64_t budget_deferred;       // Epochs whose migrations were cut short by the budget
+    uint64_t hysteresis_blocked;    // Epochs whose next exchange fell inside the margin
+    uint64_t cooldown_skipped;      // Hot or cold candidates pinned by a recent move
+    uint64_t ping_pongs;            // Migrations reversing a move made within PING_PONG_WINDOW epochs
+};
+
+#endif // FLAT_TIERING_H
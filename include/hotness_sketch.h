@@ -0,0 +1,52 @@
+#ifndef HOTNESS_SKETCH_H
+#define HOTNESS_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Fixed-memory access-frequency tracker for hot/cold classification.
+// A count-min sketch (optionally with conservative update) estimates
+// per-address counts; every `half_life` updates all counters are halved so
+// old activity fades. An optional top-K table keeps exact counts for the
+// heaviest hitters (space-saving replacement) and overrides the sketch for them.
+class HotnessSketch {
+public:
+    HotnessSketch(uint32_t width, uint32_t depth, bool conservative, uint64_t half_life, uint32_t top_k);
+
+    uint32_t increment(uint64_t key);
+    uint32_t estimate(uint64_t key) const;
+    void reset();
+
+    size_t memoryBytes() const;
+    void printStats() const;
+
+private:
+    struct TopEntry {
+        uint64_t key;
+        uint32_t count;
+    };
+
+    uint32_t sketchEstimate(uint64_t key) const;
+    void updateTopK(uint64_t key, uint32_t estimate);
+    void age();
+    uint32_t column(uint64_t key, uint32_t row) const;
+
+    uint32_t width;
+    uint32_t depth;
+    bool conservative;
+    uint64_t half_life;         // Updates between halvings (0 = never decay)
+    uint32_t top_k;
+
+    std::vector<uint32_t> counters;     // depth rows of width counters
+    std::vector<uint64_t> seeds;        // Per-row hash seeds
+    std::vector<TopEntry> top;
+    std::unordered_map<uint64_t, uint32_t> top_index;   // Key -> slot in `top`
+    uint32_t top_min;           // Lower bound on the smallest top-K count
+
+    uint64_t updates;
+    uint64_t agings;
+};
+
+#endif // HOTNESS_SKETCH_H
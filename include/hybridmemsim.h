@@ -0,0 +1,93 @@
+#ifndef HYBRIDMEMSIM_H
+#define HYBRIDMEMSIM_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+#include "memory_simulator.h"
+
+// Embeddable request/completion interface to the memory model, for driving
+// it from an external CPU/system simulator instead of trace files. Requests
+// carry a caller tag and issue cycle; the caller advances time with tick()
+// and receives completions through a callback or by polling. Requests may be
+// sent in any order: tick() simulates them in issue-cycle order once the
+// clock reaches their issue cycle, and overlapping requests contend on the
+// model's bank and flash busy-until timelines. Nothing on this path reads
+// stdin or writes to stdout.
+namespace hybridmemsim {
+
+struct Request {
+    uint64_t tag;
+    uint64_t address;
+    bool is_write;
+    uint64_t issue_cycle;
+};
+
+struct Completion {
+    uint64_t tag;
+    uint64_t address;
+    bool is_write;
+    uint64_t issue_cycle;
+    uint64_t complete_cycle;
+};
+
+typedef std::function<void(const Completion&)> CompletionCallback;
+
+class MemorySystem {
+public:
+    explicit MemorySystem(Config config);
+
+    MemorySystem(const MemorySystem&) = delete;
+    MemorySystem& operator=(const MemorySystem&) = delete;
+
+    // Queues a request; one issued before the current cycle is treated as issued now
+    void send(const Request& request);
+    void send(uint64_t tag, uint64_t address, bool is_write, uint64_t issue_cycle);
+
+    // Advances the clock, simulates every queued request issued by then and
+    // retires every request that has completed
+    void tick(uint64_t cycles = 1);
+    uint64_t cycle() const { return now; }
+
+    // With a callback set, completions are delivered from tick() and never queued
+    void setCompletionCallback(CompletionCallback callback);
+    bool pollCompletion(Completion& completion);
+
+    size_t inFlight() const { return queued.size() + pending.size(); }
+    StatsSnapshot stats() const { return simulator.snapshotStats(); }
+    void printStats() { simulator.printStats(); }
+
+private:
+    struct QueuedRequest {
+        Request request;
+        uint64_t sequence;      // Send order, breaks issue-cycle ties
+    };
+
+    struct LaterIssue {
+        bool operator()(const QueuedRequest& a, const QueuedRequest& b) const {
+            if (a.request.issue_cycle != b.request.issue_cycle) return a.request.issue_cycle > b.request.issue_cycle;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    struct LaterCompletion {
+        bool operator()(const Completion& a, const Completion& b) const {
+            return a.complete_cycle > b.complete_cycle;
+        }
+    };
+
+    MemorySimulator simulator;
+    uint64_t now;
+    uint64_t sent;
+    std::priority_queue<QueuedRequest, std::vector<QueuedRequest>, LaterIssue> queued;     // Not yet simulated
+    std::priority_queue<Completion, std::vector<Completion>, LaterCompletion> pending;   // Simulated, not yet retired
+    std::deque<Completion> completed;
+    CompletionCallback callback;
+};
+
+} // namespace hybridmemsim
+
+#endif // HYBRIDMEMSIM_H
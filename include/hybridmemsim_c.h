@@ -0,0 +1,66 @@
+#ifndef HYBRIDMEMSIM_C_H
+#define HYBRIDMEMSIM_C_H
+
+#include <stdint.h>
+
+/* Plain C binding of hybridmemsim::MemorySystem (see hybridmemsim.h). */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct hms_system hms_system;
+
+typedef struct hms_completion {
+    uint64_t tag;
+    uint64_t address;
+    int is_write;
+    uint64_t issue_cycle;
+    uint64_t complete_cycle;
+} hms_completion;
+
+typedef struct hms_stats {
+    uint64_t total_accesses;
+    uint64_t total_latency;
+    uint64_t current_cycle;
+    uint64_t row_hits;
+    uint64_t row_misses;
+    uint64_t row_empty_misses;
+    uint64_t row_conflict_misses;
+    uint64_t refresh_cycles;
+    uint64_t dram_cache_hits;
+    uint64_t dram_cache_misses;
+    uint64_t flash_reads;
+    uint64_t flash_writes;
+    uint64_t cache_promotions;
+    uint64_t cache_evictions;
+    uint64_t prefetches_issued;
+    uint64_t prefetch_hits;
+    uint64_t rejected_accesses;     /* Out-of-range addresses, completed with 0 latency */
+    uint64_t refresh_commands;
+} hms_stats;
+
+typedef void (*hms_completion_fn)(const hms_completion* completion, void* user_data);
+
+/* Returns NULL if the config file cannot be read or parsed. NULL path = ./config/default.cfg */
+hms_system* hms_create(const char* config_path);
+void hms_destroy(hms_system* system);
+
+/* Queues a request; it is simulated by the hms_tick() that reaches its issue cycle */
+void hms_send(hms_system* system, uint64_t tag, uint64_t address, int is_write, uint64_t issue_cycle);
+void hms_tick(hms_system* system, uint64_t cycles);
+uint64_t hms_cycle(const hms_system* system);
+uint64_t hms_in_flight(const hms_system* system);
+
+/* Callback mode: completions are delivered from hms_tick(). Pass NULL to return to polling. */
+void hms_set_callback(hms_system* system, hms_completion_fn callback, void* user_data);
+/* Returns 1 and fills `completion` if one is ready, 0 otherwise */
+int hms_poll(hms_system* system, hms_completion* completion);
+
+void hms_get_stats(const hms_system* system, hms_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HYBRIDMEMSIM_C_H */
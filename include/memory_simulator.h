@@ -8,6 +8,40 @@
 #include <vector>
 #include <sstream>
 #include <map>
+#include <deque>
+#include <list>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+#include "prefetcher.h"
+#include "tier_hierarchy.h"
+#include "flash_geometry.h"
+#include "reuse_profiler.h"
+#include "hotness_sketch.h"
+#include "compressed_dram.h"
+#include "cache_hierarchy.h"
+#include "phase_detector.h"
+#include "flat_tiering.h"
+
+// Row-buffer management policy applied after every DRAM access
+enum class PagePolicy {
+    OPEN,       // Leave the row open until a conflicting access arrives
+    CLOSED,     // Precharge immediately after every access
+    TIMEOUT,    // Precharge once the bank has been idle for page_timeout cycles
+    ADAPTIVE    // Per-bank predictor decides from recent row-reuse history
+};
+
+// How the DRAM+Flash pair is organised in hybrid mode
+enum class HybridModel {
+    CACHE,      // DRAM caches hot flash data (data duplicated)
+    FLAT        // Each page lives in one tier; epoch-based migration
+};
+
+// Refresh command granularity
+enum class RefreshMode {
+    ALL_BANK,   // REFab: every bank blocked for tRFC
+    PER_BANK    // REFpb: banks refreshed one at a time, others stay available
+};
 
 typedef struct config{
     // DRAM Configuration
@@ -22,22 +56,123 @@ typedef struct config{
     bool enable_flash;
     uint64_t flash_capacity;
     uint32_t flash_page_size;
+    FlashGeometryConfig flash_geometry;
+    HybridModel hybrid_model;
+
+    // Flat Tiering (hybrid_model = flat)
+    uint64_t flat_dram_capacity;    // DRAM bytes for flat-mode pages (0 = DRAM size)
+    uint64_t migration_epoch;       // Cycles between placement decisions (0 = no migration)
+    uint32_t migration_budget;      // Pages migrated per epoch (0 = unlimited)
+    double migration_hysteresis;    // Promotion must beat its victim's score by this fraction
+    uint32_t migration_cooldown;    // Epochs a migrated page stays in place
+
+    // Hotness Detection (hybrid mode)
+    bool hotness_sketch;        // false = exact per-address map, true = decaying count-min sketch
+    uint32_t sketch_width;
+    uint32_t sketch_depth;
+    bool sketch_conservative;   // Conservative update instead of plain count-min
+    uint64_t hotness_half_life; // Accesses between counter halvings (0 = no decay)
+    uint32_t hotness_topk;      // Exact top-K table size (0 = disabled)
+    uint64_t dram_cache_entries;    // Cached addresses kept, LRU (0 = DRAM lines with the sketch, else unbounded)
+
+    // Compressed DRAM Tier (hybrid mode)
+    bool dram_compression;
+    uint64_t compression_capacity;      // DRAM-tier bytes for compressed pages (0 = DRAM size)
+    std::vector<double> compression_mix;    // Fraction of pages per size class (1/N .. N/N of a page)
+    uint32_t compression_latency;       // Cycles to compress a page on promotion or write
+    uint32_t decompression_latency;     // Cycles added to a hit on a compressed page
+
+    // Flash-to-DRAM Prefetching (hybrid mode)
+    PrefetcherType prefetcher;
+    uint32_t prefetch_degree;       // Pages requested per trigger
+    uint32_t prefetch_budget;       // Max prefetches issued per prefetch_window
+    uint32_t prefetch_window;       // Budget window length in cycles
+    uint32_t prefetch_buffer_pages; // DRAM-tier pages reserved for prefetched data
+
+    // N-Tier Hierarchy (replaces the DRAM+Flash pair when non-empty)
+    std::vector<TierConfig> tiers;  // Ordered fastest to slowest
+    uint32_t tier_access_size;      // Bytes moved per demand access (bandwidth model)
+    double tier_promote_margin;     // Promotion must beat the displaced page's count by this fraction
+    uint32_t tier_cooldown;         // Accesses a migrated page stays in its new tier
+
+    // On-chip Cache Filter (optional; trace lines are then core loads/stores)
+    std::vector<CacheLevelConfig> caches;   // Ordered closest to the core first
+
+    // Automatic Phase Detection
+    bool phase_detection;
+    uint64_t phase_interval;        // Accesses per signature interval
+    uint32_t phase_region_bits;     // log2 of the address-region size hashed into signatures
+    uint32_t phase_signature_bits;
+    double phase_threshold;         // Max signature distance to an existing phase
 
     // Timing Parameters (in cycles)
     uint32_t row_access_time;
     uint32_t column_access_time;
-    uint32_t refresh_interval;
+    uint32_t refresh_interval;  // tREFI at 1x granularity
+
+    // Refresh Scheduling
+    RefreshMode refresh_mode;
+    uint32_t refresh_granularity;   // Fine-granularity refresh: 1x, 2x or 4x commands per tREFI
+    uint32_t refresh_latency;       // tRFC at 1x (0 = built-in REFRESH_LATENCY)
+    uint32_t refresh_max_postpone;  // Refreshes that may be owed before one is forced
+
+    // Row-Buffer Management
+    PagePolicy page_policy;
+    uint32_t page_timeout;      // Idle cycles before the timeout policy closes a row
+
+    // Reuse-Distance Analysis
+    bool mrc_page_granularity;  // true = flash_page_size blocks, false = mrc_line_size
+    uint32_t mrc_line_size;
+    double mrc_sampling_rate;   // 1.0 = exact, < 1.0 = SHARDS spatial sampling
+    std::string mrc_output;     // CSV path for the full miss-ratio curve (empty = none)
 
     // Simulation Parameters
     uint64_t trace_lines;  // Number of trace lines to generate for testing
+    uint32_t max_outstanding;   // Trace accesses in flight at once (1 = back-to-back)
+    bool quiet;            // Suppress informational console output (embedded use)
 } Config;
 
+// Loads `file_path` (default ./config/default.cfg) over built-in defaults; returns non-zero on error
+int read_config(std::string file_path, Config * config);
+
+// Refresh bookkeeping for one refresh unit (the rank, or a single bank in per-bank mode)
+struct RefreshState {
+    uint64_t next_due;      // Cycle the next refresh command falls due
+    uint32_t pending;       // Due but not yet issued (postponed)
+    uint64_t busy_until;    // End of the last refresh issued
+    uint64_t idle_since;    // End of the last access; owed refreshes hide after it
+
+    void reset(uint64_t first_due) {
+        next_due = first_due;
+        pending = 0;
+        busy_until = 0;
+        idle_since = 0;
+    }
+};
+
 struct Bank {
+    static constexpr uint32_t NO_OPEN_ROW = UINT32_MAX;
+
     std::vector<std::vector<uint8_t>> rows;
     uint32_t active_row;
+    uint32_t last_row;              // Row of the previous access, whether or not it is still open (reset by refresh)
+    uint64_t last_access_cycle;     // Cycle the previous access finished (busy-until, timeout policy)
+    uint8_t reuse_counter;          // 2-bit saturating row-reuse predictor (adaptive policy)
 
-    Bank(uint32_t num_rows, uint32_t cols) : active_row(-1) {
+    RefreshState refresh;           // Used in per-bank refresh mode
+    uint64_t refreshes;             // Refresh commands that covered this bank
+    uint64_t refresh_stall_cycles;  // Access time lost waiting for refresh
+
+    Bank(uint32_t num_rows, uint32_t cols) {
         rows.resize(num_rows, std::vector<uint8_t>(cols, 0));
+        resetRowBuffer();
+    }
+
+    void resetRowBuffer() {
+        active_row = NO_OPEN_ROW;
+        last_row = NO_OPEN_ROW;
+        last_access_cycle = 0;
+        reuse_counter = 2;
     }
 };
 
@@ -66,6 +201,52 @@ struct FlashMemory {
     }
 };
 
+struct PrefetchEntry {
+    uint64_t ready_cycle;   // Cycle the promoted page lands in DRAM
+    bool used;              // Touched by a demand access since it was prefetched
+};
+
+// Flat tiering: one page copy between DRAM and flash, issued in the background
+struct MigrationCopy {
+    uint64_t page_number;
+    bool to_dram;           // false = demotion written back to flash
+};
+
+// Flat tiering: a page with copies still queued or in flight
+struct MigratingPage {
+    uint32_t copies;        // Queued plus in flight
+    bool data_in_dram;      // Where the data is until the next copy completes
+};
+
+// Point-in-time copy of the headline counters
+struct StatsSnapshot {
+    uint64_t total_accesses;
+    uint64_t rejected_accesses;     // Out-of-range addresses, completed without being modelled
+    uint64_t total_latency;
+    uint64_t current_cycle;
+    uint64_t row_hits;
+    uint64_t row_misses;
+    uint64_t row_empty_misses;
+    uint64_t row_conflict_misses;
+    uint64_t refresh_cycles;        // Commands x tRFC
+    uint64_t refresh_commands;
+    uint64_t dram_cache_hits;
+    uint64_t dram_cache_misses;
+    uint64_t flash_reads;
+    uint64_t flash_writes;
+    uint64_t cache_promotions;
+    uint64_t cache_evictions;
+    uint64_t prefetches_issued;
+    uint64_t prefetch_hits;
+};
+
+// Statistics attributed to a labelled trace phase, a snapshot or a detected phase
+struct PhaseRecord {
+    std::string label;
+    uint64_t intervals;         // Detected phases: intervals classified into this phase
+    StatsSnapshot stats;
+};
+
 class MemorySimulator {
 public:
     MemorySimulator(Config config);
@@ -75,17 +256,54 @@ public:
     void initialize();
     void clear();
     void run();
+    void profileReuse();
     void printStats();
     void processAccess(char operation, uint64_t address);
+    uint64_t accessAt(char operation, uint64_t address, uint64_t issue_cycle);
     void performRefresh();
+    void resetStats();
+    StatsSnapshot snapshotStats() const;
 
 private:
     // Helper methods for hybrid memory management
     bool isHotData(uint64_t address);
-    void migrateToDRAM(uint64_t address);
-    void migrateToFlash(uint64_t address);
+    void migrateToDRAM(uint64_t page_number, uint64_t start);
+    void migrateToFlash(uint64_t page_number, uint64_t start);
+    void issueMigrations(uint64_t now);
+    void queueMigration(uint64_t page_number, bool to_dram);
     void updateAccessFrequency(uint64_t address);
     void generateTrace(uint64_t num_accesses);
+    uint64_t serviceAccess(char operation, uint64_t address);
+    bool addressInRange(uint64_t address) const;
+    uint64_t accessClock() const;
+    void processHybridAccess(char operation, uint64_t address);
+    void evictCachedAddress(uint64_t address);
+    uint64_t cachedAddressesIn(uint64_t page_number) const;
+    void dropCachedPage(uint64_t page_number);
+    void processFlatAccess(char operation, uint64_t address);
+    void runMigrationEpoch();
+    void resetMigrationState();
+    uint32_t accessDRAM(char operation, uint64_t address);
+    void applyPagePolicy(Bank& bank, bool row_known, bool row_reused);
+    uint32_t refreshStall(uint32_t bank_index, uint64_t now);
+    uint32_t issueIdleRefreshes(RefreshState& unit, uint64_t now);
+    void noteRefreshes(uint32_t bank_index, uint32_t count);
+    void resetRefreshState();
+    void submitAccess(char operation, uint64_t address);
+    void drainAccesses();
+    void observePhase(uint64_t address);
+    void waitForOutstanding();
+    bool handleTraceMarker(const std::string& line, int line_num);
+    void openTracePhase(const std::string& label);
+    void closeTracePhase();
+    void recordDetectedPhase(int phase);
+    void finishPhases();
+    void resetPhaseState();
+    void runPrefetcher(uint64_t page_number, bool flash_miss);
+    void resetPrefetchState();
+    uint32_t flashReadLatency(uint64_t page_number);
+    uint32_t flashWriteLatency(uint64_t page_number);
+    uint64_t fixedFlashAccess(uint64_t now, uint32_t latency);
 
     // Configuration
     Config sim_config;
@@ -93,37 +311,120 @@ private:
     // DRAM components
     std::vector<Bank> banks;
     uint64_t total_accesses;
+    uint64_t rejected_accesses;     // Out-of-range addresses (see addressInRange)
     uint64_t row_hits;
     uint64_t row_misses;
+    uint64_t row_empty_misses;      // Bank was precharged: activate + column access
+    uint64_t row_conflict_misses;   // Another row was open: precharge + activate + column access
+    uint64_t policy_precharges;     // Rows closed early by the page policy
+    uint64_t premature_precharges;  // Early closes followed by an access to the same row
+    uint64_t bank_busy_cycles;      // Access time lost waiting for a bank still serving an earlier request
     uint64_t total_latency;
-    uint64_t refresh_cycles;
+    uint64_t refresh_cycles;        // Time spent refreshing: commands x tRFC
+    uint64_t refresh_commands;
+    uint64_t current_cycle;         // Simulated time; accesses are serviced back-to-back
+    uint64_t service_latency_base;  // total_latency when the access in service started
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> outstanding;  // Completion cycles in flight
+
+    // Refresh scheduling
+    RefreshState rank_refresh;      // Used in all-bank refresh mode
+    uint64_t refresh_period;        // Cycles between refresh commands per unit
+    uint32_t refresh_duration;      // tRFC of one command at the configured granularity
+    uint64_t refreshes_hidden;      // Issued while the unit was idle
+    uint64_t refreshes_forced;      // Issued ahead of a waiting access (postponement exhausted)
+    uint64_t refresh_stall_cycles;
+    uint32_t max_refresh_backlog;   // Most refreshes ever owed by one unit
 
     // Flash/Hybrid memory components
     FlashMemory* flash;
+    FlashGeometry* flash_timing;    // Channel/die/plane timing (nullptr = fixed latencies)
+    uint64_t flash_busy_until;      // Fixed latencies: end of the work queued on the flash device
     bool hybrid_mode;
-    std::map<uint64_t, uint64_t> access_frequency;  // Track access counts per address
-    std::map<uint64_t, bool> data_in_dram_cache;    // true = cached in DRAM, false = Flash only
+    std::map<uint64_t, uint64_t> access_frequency;  // Track access counts per address (exact tracker)
+    HotnessSketch* hotness;                         // Fixed-memory tracker (nullptr = exact map)
+    CompressedDRAM* compressed_dram;                // Capacity-bounded compressed tier (nullptr = off)
+    std::vector<uint64_t> compression_victims;      // Pages the last compressed insert dropped
+    std::map<uint64_t, std::list<uint64_t>::iterator> data_in_dram_cache;  // Cached address -> slot in dram_cache_lru
+    std::list<uint64_t> dram_cache_lru;             // Cached addresses, most recently used first
+    uint64_t dram_cache_capacity;                   // Max cached addresses (0 = unbounded)
 
     // Flash statistics
-    uint64_t flash_reads;
+    uint64_t flash_reads;           // Demand and prefetch page reads
     uint64_t flash_writes;
     uint64_t cache_promotions;      // Cold data promoted to DRAM cache
     uint64_t cache_evictions;       // Hot data evicted from DRAM cache
+    uint64_t dram_cache_capacity_evictions;     // Evictions forced by dram_cache_capacity
     uint64_t dram_cache_hits;       // Data found in DRAM cache
     uint64_t dram_cache_misses;     // Data not in DRAM cache (Flash access)
     uint64_t dram_access_latency;
     uint64_t flash_access_latency;
     uint64_t cache_overhead;        // Cost of promotions/evictions
+    uint64_t flash_queue_cycles;    // Fixed latencies: demand time spent behind other flash work
+
+    // Flat tiering (nullptr in DRAM-as-cache mode)
+    FlatTiering* flat_tiers;
+    std::vector<uint64_t> migrate_up;
+    std::vector<uint64_t> migrate_down;
+    std::deque<MigrationCopy> pending_migrations;  // Copies decided but not yet issued
+    std::unordered_map<uint64_t, MigratingPage> migrating_pages;   // Pages whose placement has not caught up
+    MigrationCopy migration_in_flight;
+    bool migration_copying;             // migration_in_flight is valid
+    uint64_t next_migration_epoch;      // Cycle the current epoch ends (UINT64_MAX = never)
+    uint64_t migration_busy_until;      // End of the copy in flight
+    uint64_t migration_cycles;          // Time spent copying pages between tiers
+    uint64_t migrations_to_dram;        // Page copies issued flash -> DRAM
+    uint64_t migrations_to_flash;       // Page copies issued DRAM -> flash
+    uint64_t migration_mid_copy_accesses;   // Demand served from a page's old tier during its copy
+
+    // N-tier hierarchy (nullptr unless tiers are configured)
+    TierHierarchy* tiers;
+
+    // On-chip cache filter (nullptr unless caches are configured)
+    CacheHierarchy* caches;
+    std::vector<CacheRequest> pending_accesses;     // Core accesses awaiting the filter
+    std::vector<CacheRequest> memory_requests;      // Filter output for the current batch
+
+    // Trace markers (@reset, @snapshot, @phase, @roi) and automatic phase detection
+    uint64_t stats_start_cycle;     // Cycle of the last statistics reset
+    uint64_t stats_resets;
+    std::vector<PhaseRecord> trace_phases;
+    std::vector<PhaseRecord> trace_snapshots;   // Cumulative since the last reset
+    bool trace_phase_open;
+    std::string trace_phase_label;
+    StatsSnapshot trace_phase_start;
+    PhaseDetector* phase_detector;              // nullptr unless phase_detection is on
+    std::vector<PhaseRecord> detected_phases;   // Indexed by phase id
+    StatsSnapshot interval_start;
+
+    // Prefetch engine: flash pages promoted into the DRAM tier ahead of demand
+    Prefetcher* prefetcher;
+    std::unordered_map<uint64_t, PrefetchEntry> prefetch_buffer;  // Keyed by flash page number
+    std::deque<uint64_t> prefetch_order;                         // FIFO replacement order
+    std::vector<uint64_t> prefetch_candidates;
+    uint64_t prefetch_window_start;
+    uint32_t prefetch_window_issued;
+
+    // Prefetch statistics
+    uint64_t prefetches_issued;
+    uint64_t prefetches_throttled;      // Dropped by the bandwidth budget
+    uint64_t prefetch_hits;             // Prefetched pages later touched by demand (useful)
+    uint64_t prefetch_late_hits;        // Useful, but the demand access had to wait
+    uint64_t prefetch_late_cycles;
+    uint64_t prefetch_unused_evictions; // Replaced before any demand access used them
 
     // Timing constants
     const uint32_t ROW_HIT_LATENCY = 10;
+    const uint32_t ROW_EMPTY_LATENCY = 20;
     const uint32_t ROW_MISS_LATENCY = 30;
-    const uint32_t REFRESH_LATENCY = 50;
+    const uint32_t REFRESH_LATENCY = 50;       // tRFC (all-bank, 1x) unless configured
     const uint32_t FLASH_READ_LATENCY = 100;    // ~2-5x slower than DRAM
     const uint32_t FLASH_WRITE_LATENCY = 500;   // ~10x slower than DRAM
     const uint32_t CACHE_PROMOTION_LATENCY = 150;  // Cost to load Flash→DRAM cache
     const uint32_t CACHE_EVICTION_LATENCY = 50;    // Cost to evict from DRAM cache
+    const uint32_t DRAM_FILL_LATENCY = 50;      // Writing a page read from flash into DRAM
     const uint64_t HOT_DATA_THRESHOLD = 3;      // Access count threshold for caching
+    const uint32_t DRAM_CACHE_LINE_SIZE = 64;   // Bytes per cached address when sizing the DRAM cache
+    const size_t CACHE_FILTER_BATCH = 4096;     // Core accesses filtered per batch
 };
 
 #endif // MEMORY_SIMULATOR_H
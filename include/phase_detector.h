@@ -0,0 +1,43 @@
+#ifndef PHASE_DETECTOR_H
+#define PHASE_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Working-set signature phase detector.
+// Every `interval` accesses the set of touched address regions (2^region_bits
+// bytes each) is hashed into a fixed-width bit vector. The interval joins the
+// known phase whose signature is closest by relative distance
+// |A xor B| / |A or B|, or starts a new phase when none is within `threshold`.
+class PhaseDetector {
+public:
+    PhaseDetector(uint64_t interval, uint32_t region_bits, uint32_t signature_bits, double threshold);
+
+    // Returns the phase of the interval this access completed, or -1 mid-interval
+    int observe(uint64_t address);
+    // Classifies a trailing partial interval (-1 if it is empty)
+    int finish();
+    void reset();
+
+    size_t phaseCount() const { return signatures.size(); }
+    const std::vector<uint32_t>& timeline() const { return history; }
+    uint64_t transitions() const { return phase_changes; }
+
+private:
+    int classify();
+    static double distance(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+
+    uint64_t interval;
+    uint32_t region_bits;
+    uint32_t signature_bits;
+    double threshold;
+
+    std::vector<uint64_t> current;                  // Signature of the interval in progress
+    uint64_t interval_accesses;
+    std::vector<std::vector<uint64_t>> signatures;  // Latest signature per phase
+    std::vector<uint32_t> history;                  // Phase of each completed interval
+    uint64_t phase_changes;
+};
+
+#endif // PHASE_DETECTOR_H
@@ -0,0 +1,96 @@
+#ifndef PREFETCHER_H
+#define PREFETCHER_H
+
+#include <cstdint>
+#include <vector>
+
+// Flash-to-DRAM prefetcher selection for hybrid mode
+enum class PrefetcherType {
+    NONE,
+    NEXT_N,     // Fetch the next N pages after a flash miss
+    STRIDE,     // Per-region constant-stride detection
+    STREAM      // Ascending/descending stream detection with confirmation
+};
+
+// Prefetchers work on flash page numbers. observe() is called for every
+// hybrid-mode access and appends the pages it wants promoted to `candidates`;
+// the simulator decides whether the bandwidth budget allows issuing them.
+// `flash_miss` is true when the access would have gone to flash without
+// prefetching, i.e. a demand flash read or the first hit on a prefetched page.
+class Prefetcher {
+public:
+    virtual ~Prefetcher() {}
+
+    virtual void observe(uint64_t page, bool flash_miss, std::vector<uint64_t>& candidates) = 0;
+    virtual void reset() = 0;
+    virtual const char* name() const = 0;
+
+    static Prefetcher* create(PrefetcherType type, uint32_t degree);
+};
+
+class NextNPagePrefetcher : public Prefetcher {
+public:
+    NextNPagePrefetcher(uint32_t degree);
+
+    void observe(uint64_t page, bool flash_miss, std::vector<uint64_t>& candidates) override;
+    void reset() override {}
+    const char* name() const override { return "next-N-page"; }
+
+private:
+    uint32_t degree;
+};
+
+class StridePrefetcher : public Prefetcher {
+public:
+    StridePrefetcher(uint32_t degree);
+
+    void observe(uint64_t page, bool flash_miss, std::vector<uint64_t>& candidates) override;
+    void reset() override;
+    const char* name() const override { return "stride"; }
+
+private:
+    // Reference prediction table indexed by address region (traces carry no PC)
+    struct Entry {
+        uint64_t region;
+        uint64_t last_page;
+        int64_t stride;
+        uint8_t confidence;
+        bool valid;
+    };
+
+    static const uint32_t TABLE_SIZE = 64;
+    static const uint32_t REGION_SHIFT = 8;     // 256 pages per tracked region
+    static const uint8_t CONFIRM_THRESHOLD = 2;
+
+    uint32_t degree;
+    std::vector<Entry> table;
+};
+
+class StreamPrefetcher : public Prefetcher {
+public:
+    StreamPrefetcher(uint32_t degree);
+
+    void observe(uint64_t page, bool flash_miss, std::vector<uint64_t>& candidates) override;
+    void reset() override;
+    const char* name() const override { return "stream"; }
+
+private:
+    struct Stream {
+        uint64_t last_page;
+        uint64_t next_prefetch;     // First page not yet requested for this stream
+        int direction;              // +1 ascending, -1 descending, 0 not yet trained
+        uint8_t confirmations;
+        uint64_t last_use;
+        bool valid;
+    };
+
+    static const uint32_t MAX_STREAMS = 16;
+    static const uint32_t DETECT_WINDOW = 4;    // Pages a follow-up access may skip ahead
+    static const uint8_t CONFIRM_THRESHOLD = 2;
+
+    uint32_t degree;
+    uint64_t access_clock;
+    std::vector<Stream> streams;
+};
+
+#endif // PREFETCHER_H
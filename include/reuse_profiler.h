@@ -0,0 +1,49 @@
+#ifndef REUSE_PROFILER_H
+#define REUSE_PROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One-pass LRU stack-distance profiler. A Fenwick tree over access
+// timestamps marks the most recent reference of every block, so the stack
+// distance of a reuse is the number of marks after the block's previous
+// timestamp: O(log n) per access. With sampling_rate < 1 only blocks whose
+// hash falls under the rate are tracked (fixed-rate SHARDS) and distances
+// are scaled back up by 1 / rate.
+class ReuseDistanceProfiler {
+public:
+    ReuseDistanceProfiler(uint32_t block_size, double sampling_rate);
+
+    void access(uint64_t address);
+
+    // Miss ratio of a fully associative LRU cache holding `cache_bytes`
+    double missRatio(uint64_t cache_bytes) const;
+    void printCurve(uint64_t highlight_bytes) const;
+    bool writeCurve(const std::string& path) const;
+
+    uint64_t totalAccesses() const { return total_accesses; }
+    uint64_t sampledAccesses() const { return sampled_accesses; }
+
+private:
+    void mark(uint64_t slot, int delta);
+    uint64_t prefix(uint64_t slot) const;
+    void compact();
+    uint64_t scaledBlocks(uint64_t sampled_distance) const;
+
+    uint32_t block_size;
+    double sampling_rate;
+    uint64_t sample_threshold;      // Hash values below this are sampled
+
+    std::unordered_map<uint64_t, uint64_t> last_access;  // Block -> timestamp slot
+    std::vector<uint32_t> tree;     // Fenwick tree, 1-based
+    uint64_t clock;                 // Last timestamp slot handed out
+
+    std::vector<uint64_t> histogram;    // histogram[d] = reuses at sampled stack distance d
+    uint64_t cold_misses;
+    uint64_t total_accesses;
+    uint64_t sampled_accesses;
+};
+
+#endif // REUSE_PROFILER_H
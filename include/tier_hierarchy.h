@@ -0,0 +1,104 @@
+#ifndef TIER_HIERARCHY_H
+#define TIER_HIERARCHY_H
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Where newly touched pages may be allocated
+enum class TierPlacement {
+    FIRST_TOUCH,    // New pages land here while the tier has free capacity
+    PROMOTE_ONLY    // Tier is filled only by promotion from the tier below
+};
+
+// Which resident page is demoted when the tier needs room
+enum class TierEviction {
+    LRU,
+    FIFO
+};
+
+struct TierConfig {
+    std::string name;
+    uint64_t capacity;          // Bytes; the last tier is the backing store and never fills
+    uint32_t read_latency;      // Cycles
+    uint32_t write_latency;     // Cycles
+    uint32_t bandwidth;         // Bytes per cycle on the tier interface (0 = unlimited)
+    uint32_t promote_threshold; // Accesses while resident here before moving up (0 = never)
+    TierPlacement placement;
+    TierEviction eviction;
+};
+
+struct TierStats {
+    uint64_t accesses;
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t latency_cycles;    // Demand latency including queueing
+    uint64_t queue_cycles;      // Waiting for the tier interface (migrations, earlier requests)
+    uint64_t allocations;       // Pages placed here on first touch
+    uint64_t promotions_in;
+    uint64_t promotions_out;
+    uint64_t demotions_in;
+    uint64_t demotions_out;
+    uint64_t promotions_blocked;    // Eligible pages held back by the margin or a cooldown
+    uint64_t migrated_bytes;
+};
+
+// Ordered set of memory tiers (index 0 = fastest). Every page lives in
+// exactly one tier; pages move one level at a time, up when they reach the
+// tier's promotion threshold and out-count the page they would displace,
+// and down when they are evicted to make room. A migrated page stays put
+// for a cooldown so a pair of pages cannot swap back and forth.
+class TierHierarchy {
+public:
+    TierHierarchy(const std::vector<TierConfig>& tier_configs, uint32_t page_size, uint32_t access_size,
+                  double promote_margin, uint32_t cooldown);
+
+    // Services one demand access presented at cycle `now`, returns its latency
+    uint32_t access(char operation, uint64_t address, uint64_t now);
+    void reset();
+    void resetStats();          // Zero the counters, keep page placement
+    void printStats(uint64_t total_accesses) const;
+    void printSummary() const;
+
+    size_t tierCount() const { return tiers.size(); }
+    const TierConfig& tierConfig(size_t index) const { return tiers[index].config; }
+    const TierStats& tierStats(size_t index) const { return tiers[index].stats; }
+    uint64_t residentPages(size_t index) const { return tiers[index].order.size(); }
+
+private:
+    struct Tier {
+        TierConfig config;
+        uint64_t capacity_pages;    // 0 = unbounded
+        uint64_t busy_until;        // Cycle the tier interface goes idle
+        std::list<uint64_t> order;  // Front = next eviction victim
+        TierStats stats;
+    };
+
+    struct PageInfo {
+        uint32_t tier;
+        uint32_t access_count;      // Accesses since the page arrived in its tier (halved when it defends its slot)
+        uint64_t pinned_until;      // Access sequence number before which the page may not move
+        std::list<uint64_t>::iterator position;
+    };
+
+    bool isFull(uint32_t tier) const;
+    bool canPromote(const PageInfo& candidate, uint32_t to);
+    uint32_t allocate(uint64_t page);
+    void place(uint64_t page, uint32_t tier, PageInfo& info);
+    void migrate(uint64_t page, uint32_t to, uint64_t now);
+    void makeRoom(uint32_t tier, uint64_t now);
+    uint64_t occupy(Tier& tier, uint64_t now, uint64_t bytes);
+    uint64_t transferCycles(const Tier& tier, uint64_t bytes) const;
+
+    std::vector<Tier> tiers;
+    std::unordered_map<uint64_t, PageInfo> pages;
+    uint32_t page_size;
+    uint32_t access_size;
+    double promote_margin;
+    uint32_t cooldown;
+    uint64_t access_sequence;   // Demand accesses seen, the clock for cooldowns
+};
+
+#endif // TIER_HIERARCHY_H
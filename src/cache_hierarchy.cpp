@@ -0,0 +1,250 @@
+#include "./../include/cache_hierarchy.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static const char* inclusionName(CacheInclusion inclusion) {
+    switch (inclusion) {
+        case CacheInclusion::INCLUSIVE: return "inclusive";
+        case CacheInclusion::EXCLUSIVE: return "exclusive";
+        default:                        return "non-inclusive";
+    }
+}
+
+int CacheHierarchy::Level::find(const uint64_t* entries, uint64_t line) const {
+    // Dirty bit is masked out of the comparison
+    uint64_t wanted = (line << 2) | VALID | DIRTY;
+    for (uint32_t way = 0; way < ways; way++) {
+        if ((entries[way] | DIRTY) == wanted) return (int)way;
+    }
+    return -1;
+}
+
+void CacheHierarchy::Level::promote(uint64_t* entries, int way) const {
+    if (way == 0) return;
+    uint64_t entry = entries[way];
+    memmove(entries + 1, entries, way * sizeof(uint64_t));
+    entries[0] = entry;
+}
+
+void CacheHierarchy::Level::remove(uint64_t* entries, int way) const {
+    // Invalid ways collect at the LRU end
+    memmove(entries + way, entries + way + 1, (ways - way - 1) * sizeof(uint64_t));
+    entries[ways - 1] = 0;
+}
+
+CacheHierarchy::CacheHierarchy(const vector<CacheLevelConfig>& level_configs) : output(nullptr) {
+    for (const CacheLevelConfig& config : level_configs) {
+        Level level;
+        level.config = config;
+        level.line_shift = 0;
+        while ((2u << level.line_shift) <= max<uint32_t>(1, config.line_size)) level.line_shift++;
+        level.config.line_size = 1u << level.line_shift;
+        level.ways = max<uint32_t>(1, config.associativity);
+        level.sets = (uint32_t)max<uint64_t>(1, config.size / ((uint64_t)level.config.line_size * level.ways));
+        level.tags.assign((size_t)level.sets * level.ways, 0);
+        levels.push_back(level);
+    }
+    reset();
+}
+
+void CacheHierarchy::reset() {
+    for (Level& level : levels) {
+        fill(level.tags.begin(), level.tags.end(), 0);
+    }
+    resetStats();
+}
+
+void CacheHierarchy::resetStats() {
+    for (Level& level : levels) {
+        level.stats = CacheLevelStats{0, 0, 0, 0};
+    }
+    core_accesses = 0;
+    memory_reads = 0;
+    memory_writes = 0;
+}
+
+void CacheHierarchy::accessBatch(const CacheRequest* requests, size_t count, vector<CacheRequest>& out) {
+    output = &out;
+    core_accesses += count;
+    if (levels.empty()) {
+        for (size_t i = 0; i < count; i++) access(0, requests[i].operation, requests[i].address);
+        return;
+    }
+
+    Level& first = levels[0];
+    for (size_t i = 0; i < count; i++) {
+        const CacheRequest& request = requests[i];
+
+        // Fast path: most core accesses hit the first level
+        uint64_t line = request.address >> first.line_shift;
+        uint64_t* entries = first.set(line);
+        int way = first.find(entries, line);
+        if (way >= 0 && (request.operation == 'R' || first.config.write_back)) {
+            first.stats.hits++;
+            first.promote(entries, way);
+            if (request.operation == 'W') entries[0] |= DIRTY;
+            continue;
+        }
+        access(0, request.operation, request.address);
+    }
+}
+
+bool CacheHierarchy::access(size_t index, char operation, uint64_t address) {
+    // Operations: 'R' read/fill, 'W' write, 'B' dirty victim, 'E' clean victim for an exclusive level.
+    // Returns whether a line handed to the caller on a fill is dirty.
+    if (index == levels.size()) {
+        // Main memory; clean victims are simply dropped
+        if (operation == 'R') {
+            memory_reads++;
+            output->push_back(CacheRequest{address, 'R'});
+        } else if (operation != 'E') {
+            memory_writes++;
+            output->push_back(CacheRequest{address, 'W'});
+        }
+        return false;
+    }
+
+    Level& level = levels[index];
+    bool exclusive = index > 0 && level.config.inclusion == CacheInclusion::EXCLUSIVE;
+    uint64_t line = address >> level.line_shift;
+    uint64_t line_address = line << level.line_shift;
+    uint64_t* entries = level.set(line);
+    int way = level.find(entries, line);
+    bool demand = (operation == 'R' || operation == 'W');
+
+    if (way >= 0) {
+        if (demand) level.stats.hits++;
+        level.promote(entries, way);
+        if (operation == 'R' && exclusive) {
+            // The line moves up to the inner level and takes its dirty state along
+            bool dirty = (entries[0] & DIRTY) != 0;
+            level.remove(entries, 0);
+            return dirty;
+        }
+        if (operation == 'W' || operation == 'B') {
+            if (level.config.write_back) {
+                entries[0] |= DIRTY;
+            } else {
+                access(index + 1, operation, line_address);
+            }
+        }
+        return false;
+    }
+
+    if (demand) level.stats.misses++;
+
+    if (operation == 'E') {
+        install(index, line, false);
+        return false;
+    }
+    if (operation == 'B') {
+        if (level.config.write_back) {
+            install(index, line, true);
+        } else {
+            access(index + 1, 'B', line_address);
+        }
+        return false;
+    }
+    if (operation == 'W' && (!level.config.write_back || exclusive)) {
+        // No write-allocate: the write continues outward
+        access(index + 1, 'W', line_address);
+        return false;
+    }
+
+    bool dirty = access(index + 1, 'R', line_address);
+    if (exclusive) return dirty;
+    install(index, line, dirty || operation == 'W');
+    return false;
+}
+
+void CacheHierarchy::install(size_t index, uint64_t line, bool dirty) {
+    Level& level = levels[index];
+    uint64_t* entries = level.set(line);
+    uint64_t victim = entries[level.ways - 1];
+
+    memmove(entries + 1, entries, (level.ways - 1) * sizeof(uint64_t));
+    entries[0] = (line << 2) | VALID | ((dirty && level.config.write_back) ? DIRTY : 0);
+    if (dirty && !level.config.write_back) {
+        // A write-through level cannot hold dirty data handed up by an exclusive level
+        access(index + 1, 'W', line << level.line_shift);
+    }
+
+    if ((victim & VALID) == 0) return;
+
+    uint64_t victim_address = (victim >> 2) << level.line_shift;
+    bool victim_dirty = (victim & DIRTY) != 0;
+    if (index > 0 && level.config.inclusion == CacheInclusion::INCLUSIVE) {
+        victim_dirty |= backInvalidate(index, victim_address, level.config.line_size);
+    }
+
+    if (victim_dirty) {
+        level.stats.writebacks++;
+        access(index + 1, 'B', victim_address);
+    } else if (index + 1 < levels.size() && levels[index + 1].config.inclusion == CacheInclusion::EXCLUSIVE) {
+        access(index + 1, 'E', victim_address);
+    }
+}
+
+bool CacheHierarchy::backInvalidate(size_t index, uint64_t address, uint32_t bytes) {
+    // Drop every inner copy of an inclusive level's victim; dirty copies merge into it
+    bool dirty = false;
+    for (size_t inner = 0; inner < index; inner++) {
+        Level& level = levels[inner];
+        for (uint64_t offset = 0; offset < bytes; offset += level.config.line_size) {
+            uint64_t line = (address + offset) >> level.line_shift;
+            uint64_t* entries = level.set(line);
+            int way = level.find(entries, line);
+            if (way < 0) continue;
+            dirty |= (entries[way] & DIRTY) != 0;
+            level.remove(entries, way);
+            levels[index].stats.back_invalidations++;
+        }
+    }
+    return dirty;
+}
+
+size_t CacheHierarchy::memoryBytes() const {
+    size_t bytes = 0;
+    for (const Level& level : levels) bytes += level.tags.size() * sizeof(uint64_t);
+    return bytes;
+}
+
+void CacheHierarchy::printSummary() const {
+    cout << "Cache filter enabled: " << levels.size() << " levels, " << memoryBytes() << " bytes of tags" << endl;
+    for (size_t i = 0; i < levels.size(); i++) {
+        const CacheLevelConfig& config = levels[i].config;
+        cout << "  " << config.name << ": " << config.size << " bytes, " << levels[i].ways << "-way, "
+             << config.line_size << "-byte lines, " << (config.write_back ? "write-back" : "write-through");
+        if (i > 0) cout << ", " << inclusionName(config.inclusion);
+        cout << endl;
+    }
+}
+
+void CacheHierarchy::printStats() const {
+    cout << "Core Accesses:             " << core_accesses << endl;
+    cout << "Memory Requests:           " << memory_reads + memory_writes
+         << " (reads: " << memory_reads << ", writes: " << memory_writes << ")" << endl;
+    if (memory_reads + memory_writes > 0) {
+        double reduction = (double)core_accesses / (memory_reads + memory_writes);
+        cout << "Traffic Reduction:         " << fixed << setprecision(2) << reduction << "x" << endl;
+    }
+
+    for (const Level& level : levels) {
+        const CacheLevelStats& stats = level.stats;
+        uint64_t lookups = stats.hits + stats.misses;
+        cout << "  " << level.config.name << ":" << string(level.config.name.size() < 24 ? 24 - level.config.name.size() : 1, ' ')
+             << stats.hits << " hits, " << stats.misses << " misses";
+        if (lookups > 0) {
+            cout << " (" << fixed << setprecision(2) << (double)stats.misses / lookups * 100.0 << "% miss)";
+        }
+        cout << ", " << stats.writebacks << " writebacks";
+        if (level.config.inclusion == CacheInclusion::INCLUSIVE && stats.back_invalidations > 0) {
+            cout << ", " << stats.back_invalidations << " back-invalidations";
+        }
+        cout << endl;
+    }
+}
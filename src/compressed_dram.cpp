@@ -0,0 +1,206 @@
+#include "./../include/compressed_dram.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+static uint64_t mix64(uint64_t value) {
+    value = (value ^ (value >> 33)) * 0xFF51AFD7ED558CCDULL;
+    value = (value ^ (value >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+    return value ^ (value >> 33);
+}
+
+void CompressedDRAM::Pool::touch(uint64_t page) {
+    auto entry = pages.find(page);
+    if (entry == pages.end()) return;
+    lru.splice(lru.begin(), lru, entry->second.second);
+}
+
+uint64_t CompressedDRAM::Pool::insert(uint64_t page, uint32_t bytes, vector<uint64_t>* victims) {
+    uint64_t evicted = 0;
+    if (bytes > capacity) return evicted;   // Larger than the whole pool: leave it untouched
+    while (used + bytes > capacity && !lru.empty()) {
+        if (victims != nullptr) victims->push_back(lru.back());
+        erase(lru.back());
+        evicted++;
+    }
+
+    lru.push_front(page);
+    pages[page] = make_pair(bytes, lru.begin());
+    used += bytes;
+    return evicted;
+}
+
+void CompressedDRAM::Pool::erase(uint64_t page) {
+    auto entry = pages.find(page);
+    if (entry == pages.end()) return;
+    used -= entry->second.first;
+    lru.erase(entry->second.second);
+    pages.erase(entry);
+}
+
+void CompressedDRAM::Pool::clear() {
+    used = 0;
+    lru.clear();
+    pages.clear();
+}
+
+CompressedDRAM::CompressedDRAM(uint64_t capacity_bytes, uint32_t page_size, const vector<double>& mix,
+                               uint32_t compress_latency, uint32_t decompress_latency)
+    : capacity(capacity_bytes), page_size(max<uint32_t>(1, page_size)),
+      compress_latency(compress_latency), decompress_latency(decompress_latency) {
+    double total = 0.0;
+    for (double fraction : mix) total += max(0.0, fraction);
+    double running = 0.0;
+    for (double fraction : mix) {
+        running += (total > 0.0) ? max(0.0, fraction) / total : 0.0;
+        cumulative_mix.push_back(running);
+    }
+    if (cumulative_mix.empty()) cumulative_mix.push_back(1.0);  // Everything incompressible
+
+    compressed.capacity = capacity;
+    shadow.capacity = capacity;
+    reset();
+}
+
+void CompressedDRAM::reset() {
+    compressed.clear();
+    shadow.clear();
+    annotated_size.clear();
+    resetStats();
+}
+
+void CompressedDRAM::resetStats() {
+    insertions = 0;
+    capacity_evictions = 0;
+    oversize_rejections = 0;
+    decompressions = 0;
+    recompressions = 0;
+    hits_gained = 0;
+    hits_lost = 0;
+    peak_logical_bytes = (uint64_t)compressed.pages.size() * page_size;
+    codec_cycles = 0;
+}
+
+uint32_t CompressedDRAM::compressedSize(uint64_t page) const {
+    auto annotated = annotated_size.find(page);
+    if (annotated != annotated_size.end()) return annotated->second;
+
+    // Stable per-page draw from the size-class mix
+    double draw = (double)(mix64(page) >> 11) / (double)(1ULL << 53);
+    size_t size_class = 0;
+    while (size_class + 1 < cumulative_mix.size() && draw >= cumulative_mix[size_class]) size_class++;
+    return (uint32_t)((uint64_t)page_size * (size_class + 1) / cumulative_mix.size());
+}
+
+void CompressedDRAM::annotate(uint64_t page, double ratio) {
+    if (ratio < 1.0) ratio = 1.0;
+    annotated_size[page] = max<uint32_t>(1, (uint32_t)(page_size / ratio));
+}
+
+bool CompressedDRAM::contains(uint64_t page) const {
+    return compressed.contains(page);
+}
+
+bool CompressedDRAM::insert(uint64_t page, uint32_t& latency, vector<uint64_t>& dropped) {
+    dropped.clear();
+    latency = 0;
+    if (compressed.contains(page)) {
+        compressed.touch(page);
+        shadow.touch(page);
+        return true;
+    }
+
+    uint32_t bytes = compressedSize(page);
+    if (bytes > compressed.capacity) {
+        oversize_rejections++;
+        return false;
+    }
+    insertions++;
+    capacity_evictions += compressed.insert(page, bytes, &dropped);
+    if (shadow.contains(page)) {
+        shadow.touch(page);
+    } else {
+        shadow.insert(page, page_size);
+    }
+
+    // Uncompressed bytes held = resident pages x page size
+    uint64_t logical = (uint64_t)compressed.pages.size() * page_size;
+    peak_logical_bytes = max(peak_logical_bytes, logical);
+
+    if (bytes >= page_size) return true;
+    codec_cycles += compress_latency;
+    latency = compress_latency;
+    return true;
+}
+
+void CompressedDRAM::evict(uint64_t page) {
+    compressed.erase(page);
+    shadow.erase(page);
+}
+
+uint32_t CompressedDRAM::hit(uint64_t page, bool write) {
+    auto entry = compressed.pages.find(page);
+    if (entry == compressed.pages.end()) return 0;
+    compressed.touch(page);
+    shadow.touch(page);
+
+    // Incompressible pages are stored raw and pay nothing
+    if (entry->second.first >= page_size) return 0;
+    decompressions++;
+    uint32_t latency = decompress_latency;
+    if (write) {
+        recompressions++;
+        latency += compress_latency;
+    }
+    codec_cycles += latency;
+    return latency;
+}
+
+void CompressedDRAM::observe(uint64_t page) {
+    bool resident = compressed.contains(page);
+    bool shadow_resident = shadow.contains(page);
+    if (resident && !shadow_resident) hits_gained++;
+    if (!resident && shadow_resident) hits_lost++;
+
+    // The shadow pool sees every lookup, including pages only it still holds
+    if (shadow_resident) shadow.touch(page);
+}
+
+void CompressedDRAM::printSummary() const {
+    cout << "Compressed DRAM tier enabled: " << capacity << " bytes, " << cumulative_mix.size()
+         << " size classes, decompression " << decompress_latency << " cycles" << endl;
+}
+
+void CompressedDRAM::printStats() const {
+    uint64_t resident = compressed.pages.size();
+    uint64_t logical = resident * page_size;
+
+    cout << "Physical Capacity:         " << capacity << " bytes (" << capacity / page_size
+         << " uncompressed pages)" << endl;
+    cout << "Resident Pages:            " << resident << " (" << compressed.used << " bytes compressed, "
+         << logical << " bytes uncompressed)" << endl;
+    if (compressed.used > 0) {
+        // Effective capacity if the whole tier packed like the resident pages
+        double ratio = (double)logical / compressed.used;
+        cout << "Compression Ratio:         " << fixed << setprecision(2) << ratio << "x" << endl;
+        cout << "Effective Capacity:        " << (uint64_t)(capacity * ratio) << " bytes (gain "
+             << fixed << setprecision(2) << ratio << "x)" << endl;
+    }
+    cout << "Peak Data Held:            " << peak_logical_bytes << " bytes uncompressed" << endl;
+    cout << "Pages Inserted:            " << insertions << " (capacity evictions: " << capacity_evictions << ")" << endl;
+    if (oversize_rejections > 0) {
+        cout << "Pages Too Large:           " << oversize_rejections << " (compressed size exceeds the tier, not cached)" << endl;
+    }
+    cout << "Decompressions:            " << decompressions << " (recompressed on write: " << recompressions << ")" << endl;
+    cout << "Codec Latency:             " << codec_cycles << " cycles" << endl;
+
+    // Shadow comparison: same promotions into an uncompressed pool of equal size.
+    // A lookup that misses the tier costs a flash page read (promotion or direct read).
+    int64_t saved = (int64_t)hits_gained - (int64_t)hits_lost;
+    cout << "Flash Reads Avoided:       " << hits_gained << " (hits an uncompressed tier would miss)" << endl;
+    cout << "Flash Reads Added:         " << hits_lost << " (misses an uncompressed tier would hit)" << endl;
+    cout << "Net Flash Traffic Change:  " << (saved > 0 ? "-" : "+") << (saved > 0 ? saved : -saved)
+         << " reads vs. uncompressed DRAM" << endl;
+}
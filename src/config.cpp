@@ -0,0 +1,476 @@
+#include "./../include/memory_simulator.h"
+
+using namespace std;
+
+static TierConfig default_tier_config(const string& name) {
+    TierConfig tier;
+    tier.name = name;
+    tier.capacity = 0;
+    tier.read_latency = 100;
+    tier.write_latency = 100;
+    tier.bandwidth = 0;
+    tier.promote_threshold = 3;
+    tier.placement = TierPlacement::FIRST_TOUCH;
+    tier.eviction = TierEviction::LRU;
+    return tier;
+}
+
+static CacheLevelConfig default_cache_config(const string& name) {
+    CacheLevelConfig level;
+    level.name = name;
+    level.size = 32768;
+    level.associativity = 8;
+    level.line_size = 64;
+    level.write_back = true;
+    level.inclusion = CacheInclusion::NON_INCLUSIVE;
+    return level;
+}
+
+static int parse_cache_field(CacheLevelConfig& level, const string& field, const string& value_str) {
+    if (field == "size") {
+        level.size = stoull(value_str);
+    } else if (field == "associativity") {
+        level.associativity = stoul(value_str);
+    } else if (field == "line_size") {
+        level.line_size = stoul(value_str);
+    } else if (field == "write_policy") {
+        if (value_str == "write_back") {
+            level.write_back = true;
+        } else if (value_str == "write_through") {
+            level.write_back = false;
+        } else {
+            return 1;
+        }
+    } else if (field == "inclusion") {
+        if (value_str == "non_inclusive") {
+            level.inclusion = CacheInclusion::NON_INCLUSIVE;
+        } else if (value_str == "inclusive") {
+            level.inclusion = CacheInclusion::INCLUSIVE;
+        } else if (value_str == "exclusive") {
+            level.inclusion = CacheInclusion::EXCLUSIVE;
+        } else {
+            return 1;
+        }
+    } else {
+        return 1;
+    }
+    return 0;
+}
+
+static int parse_tier_field(TierConfig& tier, const string& field, const string& value_str) {
+    if (field == "capacity") {
+        tier.capacity = stoull(value_str);
+    } else if (field == "read_latency") {
+        tier.read_latency = stoul(value_str);
+    } else if (field == "write_latency") {
+        tier.write_latency = stoul(value_str);
+    } else if (field == "bandwidth") {
+        tier.bandwidth = stoul(value_str);
+    } else if (field == "promote_threshold") {
+        tier.promote_threshold = stoul(value_str);
+    } else if (field == "placement") {
+        if (value_str == "first_touch") {
+            tier.placement = TierPlacement::FIRST_TOUCH;
+        } else if (value_str == "promote_only") {
+            tier.placement = TierPlacement::PROMOTE_ONLY;
+        } else {
+            return 1;
+        }
+    } else if (field == "eviction") {
+        if (value_str == "lru") {
+            tier.eviction = TierEviction::LRU;
+        } else if (value_str == "fifo") {
+            tier.eviction = TierEviction::FIFO;
+        } else {
+            return 1;
+        }
+    } else {
+        return 1;
+    }
+    return 0;
+}
+
+
+int read_config(string file_path, Config * config){
+    // Use default config path if empty
+    if (file_path.empty()) {
+        file_path = "./config/default.cfg";
+    }
+
+    ifstream file(file_path);
+    if (!file.is_open()) {
+        cerr << "ERROR: Could not open config file: " << file_path << endl;
+        return 1;
+    }
+
+    // Set defaults
+    config->initial_value = 0;
+    config->bank_count = 8;
+    config->bank_size = 1024;
+    config->dram_banks = 8;
+    config->dram_rows = 32768;
+    config->dram_columns = 1024;
+    config->row_access_time = 50;
+    config->column_access_time = 15;
+    config->refresh_interval = 64000;
+    config->refresh_mode = RefreshMode::ALL_BANK;
+    config->refresh_granularity = 1;
+    config->refresh_latency = 0;
+    config->refresh_max_postpone = 8;
+    config->enable_flash = false;
+    config->flash_capacity = 1073741824;
+    config->flash_page_size = 4096;
+    config->trace_lines = 1000; // Default trace size
+    config->max_outstanding = 1;
+    config->quiet = false;
+    config->page_policy = PagePolicy::OPEN;
+    config->page_timeout = 200;
+    config->hotness_sketch = false;
+    config->sketch_width = 65536;
+    config->sketch_depth = 4;
+    config->sketch_conservative = true;
+    config->hotness_half_life = 1000000;
+    config->hotness_topk = 64;
+    config->dram_cache_entries = 0;
+    config->hybrid_model = HybridModel::CACHE;
+    config->flat_dram_capacity = 0;
+    config->migration_epoch = 1000000;
+    config->migration_budget = 256;
+    config->migration_hysteresis = 0.25;
+    config->migration_cooldown = 2;
+    config->dram_compression = false;
+    config->compression_capacity = 0;
+    config->compression_mix = {0.25, 0.35, 0.25, 0.15};
+    config->compression_latency = 40;
+    config->decompression_latency = 20;
+    config->prefetcher = PrefetcherType::NONE;
+    config->prefetch_degree = 4;
+    config->prefetch_budget = 64;
+    config->prefetch_window = 10000;
+    config->prefetch_buffer_pages = 1024;
+    config->flash_geometry = FlashGeometryConfig{false, 8, 4, 2, 256, 60, 450, 256, 20, true, 20, 3};
+    config->mrc_page_granularity = true;
+    config->mrc_line_size = 64;
+    config->mrc_sampling_rate = 1.0;
+    config->mrc_output = "";
+    config->tiers.clear();
+    config->tier_access_size = 64;
+    config->tier_promote_margin = 0.5;
+    config->tier_cooldown = 10000;
+    config->caches.clear();
+    config->phase_detection = false;
+    config->phase_interval = 100000;
+    config->phase_region_bits = 16;
+    config->phase_signature_bits = 1024;
+    config->phase_threshold = 0.5;
+
+    // Tier parameters may appear before or after the ordered tier list
+    vector<string> tier_order;
+    map<string, TierConfig> tier_params;
+    vector<string> cache_order;
+    map<string, CacheLevelConfig> cache_params;
+
+    string line;
+    while (getline(file, line)) {
+        // Skip empty lines and comments
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // Parse key = value format
+        istringstream iss(line);
+        string key, equals, value_str;
+
+        if (iss >> key >> equals && equals == "=") {
+            // Read rest of line as value (handles bool and numeric types)
+            iss >> value_str;
+
+            // DRAM Configuration
+            if (key == "dram_banks") {
+                config->dram_banks = stoul(value_str);
+                config->bank_count = config->dram_banks;
+            } else if (key == "dram_columns") {
+                config->dram_columns = stoul(value_str);
+            } else if (key == "dram_rows") {
+                config->dram_rows = stoul(value_str);
+            } else if (key == "row_buffer_size") {
+                config->bank_size = stoul(value_str);
+            }
+            // Flash/Hybrid Configuration
+            else if (key == "enable_flash") {
+                config->enable_flash = (value_str == "true" || value_str == "1");
+            } else if (key == "flash_capacity") {
+                config->flash_capacity = stoull(value_str);
+            } else if (key == "flash_page_size") {
+                config->flash_page_size = stoul(value_str);
+            }
+            // Hotness Detection
+            else if (key == "hotness_tracker") {
+                if (value_str == "exact") {
+                    config->hotness_sketch = false;
+                } else if (value_str == "sketch") {
+                    config->hotness_sketch = true;
+                } else {
+                    cerr << "WARNING: Unknown hotness_tracker '" << value_str << "', using exact" << endl;
+                    config->hotness_sketch = false;
+                }
+            } else if (key == "sketch_width") {
+                config->sketch_width = stoul(value_str);
+            } else if (key == "sketch_depth") {
+                config->sketch_depth = stoul(value_str);
+            } else if (key == "sketch_conservative") {
+                config->sketch_conservative = (value_str == "true" || value_str == "1");
+            } else if (key == "hotness_half_life") {
+                config->hotness_half_life = stoull(value_str);
+            } else if (key == "hotness_topk") {
+                config->hotness_topk = stoul(value_str);
+            } else if (key == "dram_cache_entries") {
+                config->dram_cache_entries = stoull(value_str);
+            }
+            // Hybrid Organisation / Flat Tiering
+            else if (key == "hybrid_model") {
+                if (value_str == "cache") {
+                    config->hybrid_model = HybridModel::CACHE;
+                } else if (value_str == "flat") {
+                    config->hybrid_model = HybridModel::FLAT;
+                } else {
+                    cerr << "WARNING: Unknown hybrid_model '" << value_str << "', using cache" << endl;
+                    config->hybrid_model = HybridModel::CACHE;
+                }
+            } else if (key == "flat_dram_capacity") {
+                config->flat_dram_capacity = stoull(value_str);
+            } else if (key == "migration_epoch") {
+                config->migration_epoch = stoull(value_str);
+            } else if (key == "migration_budget") {
+                config->migration_budget = stoul(value_str);
+            } else if (key == "migration_hysteresis") {
+                config->migration_hysteresis = stod(value_str);
+            } else if (key == "migration_cooldown") {
+                config->migration_cooldown = stoul(value_str);
+            }
+            // Compressed DRAM Tier
+            else if (key == "dram_compression") {
+                config->dram_compression = (value_str == "true" || value_str == "1");
+            } else if (key == "compression_capacity") {
+                config->compression_capacity = stoull(value_str);
+            } else if (key == "compression_mix") {
+                config->compression_mix.clear();
+                stringstream fractions(value_str);
+                string fraction;
+                while (getline(fractions, fraction, ',')) {
+                    if (!fraction.empty()) config->compression_mix.push_back(stod(fraction));
+                }
+            } else if (key == "compression_latency") {
+                config->compression_latency = stoul(value_str);
+            } else if (key == "decompression_latency") {
+                config->decompression_latency = stoul(value_str);
+            }
+            // Flash Geometry
+            else if (key == "flash_geometry") {
+                config->flash_geometry.enabled = (value_str == "true" || value_str == "1");
+            } else if (key == "flash_channels") {
+                config->flash_geometry.channels = stoul(value_str);
+            } else if (key == "flash_dies_per_channel") {
+                config->flash_geometry.dies_per_channel = stoul(value_str);
+            } else if (key == "flash_planes_per_die") {
+                config->flash_geometry.planes_per_die = stoul(value_str);
+            } else if (key == "flash_pages_per_block") {
+                config->flash_geometry.pages_per_block = stoul(value_str);
+            } else if (key == "flash_read_time") {
+                config->flash_geometry.read_time = stoul(value_str);
+            } else if (key == "flash_program_time") {
+                config->flash_geometry.program_time = stoul(value_str);
+            } else if (key == "flash_channel_bandwidth") {
+                config->flash_geometry.channel_bandwidth = stoul(value_str);
+            } else if (key == "flash_multiplane_window") {
+                config->flash_geometry.multiplane_window = stoul(value_str);
+            } else if (key == "flash_read_suspend") {
+                config->flash_geometry.read_suspend = (value_str == "true" || value_str == "1");
+            } else if (key == "flash_suspend_latency") {
+                config->flash_geometry.suspend_latency = stoul(value_str);
+            } else if (key == "flash_max_suspends") {
+                config->flash_geometry.max_suspends = stoul(value_str);
+            }
+            // Flash-to-DRAM Prefetching
+            else if (key == "prefetcher") {
+                if (value_str == "none") {
+                    config->prefetcher = PrefetcherType::NONE;
+                } else if (value_str == "next_n") {
+                    config->prefetcher = PrefetcherType::NEXT_N;
+                } else if (value_str == "stride") {
+                    config->prefetcher = PrefetcherType::STRIDE;
+                } else if (value_str == "stream") {
+                    config->prefetcher = PrefetcherType::STREAM;
+                } else {
+                    cerr << "WARNING: Unknown prefetcher '" << value_str << "', prefetching disabled" << endl;
+                    config->prefetcher = PrefetcherType::NONE;
+                }
+            } else if (key == "prefetch_degree") {
+                config->prefetch_degree = stoul(value_str);
+            } else if (key == "prefetch_budget") {
+                config->prefetch_budget = stoul(value_str);
+            } else if (key == "prefetch_window") {
+                config->prefetch_window = stoul(value_str);
+            } else if (key == "prefetch_buffer_pages") {
+                config->prefetch_buffer_pages = stoul(value_str);
+            }
+            // Timing Parameters
+            else if (key == "row_access_time") {
+                config->row_access_time = stoul(value_str);
+            } else if (key == "column_access_time") {
+                config->column_access_time = stoul(value_str);
+            } else if (key == "refresh_interval") {
+                config->refresh_interval = stoul(value_str);
+            }
+            // Refresh Scheduling
+            else if (key == "refresh_mode") {
+                if (value_str == "all_bank") {
+                    config->refresh_mode = RefreshMode::ALL_BANK;
+                } else if (value_str == "per_bank") {
+                    config->refresh_mode = RefreshMode::PER_BANK;
+                } else {
+                    cerr << "WARNING: Unknown refresh_mode '" << value_str << "', using all_bank" << endl;
+                    config->refresh_mode = RefreshMode::ALL_BANK;
+                }
+            } else if (key == "refresh_granularity") {
+                config->refresh_granularity = stoul(value_str);
+                if (config->refresh_granularity != 1 && config->refresh_granularity != 2 &&
+                    config->refresh_granularity != 4) {
+                    cerr << "WARNING: refresh_granularity must be 1, 2 or 4, using 1" << endl;
+                    config->refresh_granularity = 1;
+                }
+            } else if (key == "refresh_latency") {
+                config->refresh_latency = stoul(value_str);
+            } else if (key == "refresh_max_postpone") {
+                config->refresh_max_postpone = stoul(value_str);
+            }
+            // Row-Buffer Management
+            else if (key == "page_policy") {
+                if (value_str == "open") {
+                    config->page_policy = PagePolicy::OPEN;
+                } else if (value_str == "closed") {
+                    config->page_policy = PagePolicy::CLOSED;
+                } else if (value_str == "timeout") {
+                    config->page_policy = PagePolicy::TIMEOUT;
+                } else if (value_str == "adaptive") {
+                    config->page_policy = PagePolicy::ADAPTIVE;
+                } else {
+                    cerr << "WARNING: Unknown page_policy '" << value_str << "', using open" << endl;
+                    config->page_policy = PagePolicy::OPEN;
+                }
+            } else if (key == "page_timeout") {
+                config->page_timeout = stoul(value_str);
+            }
+            // N-Tier Hierarchy
+            else if (key == "tiers") {
+                tier_order.clear();
+                stringstream names(value_str);
+                string name;
+                while (getline(names, name, ',')) {
+                    if (!name.empty()) tier_order.push_back(name);
+                }
+            } else if (key == "tier_access_size") {
+                config->tier_access_size = stoul(value_str);
+            } else if (key == "tier_promote_margin") {
+                config->tier_promote_margin = stod(value_str);
+            } else if (key == "tier_cooldown") {
+                config->tier_cooldown = stoul(value_str);
+            } else if (key.compare(0, 5, "tier.") == 0) {
+                size_t dot = key.find('.', 5);
+                if (dot == string::npos) {
+                    cerr << "WARNING: Malformed tier key '" << key << "'" << endl;
+                    continue;
+                }
+                string name = key.substr(5, dot - 5);
+                auto tier = tier_params.find(name);
+                if (tier == tier_params.end()) {
+                    tier = tier_params.emplace(name, default_tier_config(name)).first;
+                }
+                if (parse_tier_field(tier->second, key.substr(dot + 1), value_str)) {
+                    cerr << "WARNING: Invalid tier setting '" << key << " = " << value_str << "'" << endl;
+                }
+            }
+            // On-chip Cache Filter
+            else if (key == "caches") {
+                cache_order.clear();
+                stringstream names(value_str);
+                string name;
+                while (getline(names, name, ',')) {
+                    if (!name.empty()) cache_order.push_back(name);
+                }
+            } else if (key.compare(0, 6, "cache.") == 0) {
+                size_t dot = key.find('.', 6);
+                if (dot == string::npos) {
+                    cerr << "WARNING: Malformed cache key '" << key << "'" << endl;
+                    continue;
+                }
+                string name = key.substr(6, dot - 6);
+                auto level = cache_params.find(name);
+                if (level == cache_params.end()) {
+                    level = cache_params.emplace(name, default_cache_config(name)).first;
+                }
+                if (parse_cache_field(level->second, key.substr(dot + 1), value_str)) {
+                    cerr << "WARNING: Invalid cache setting '" << key << " = " << value_str << "'" << endl;
+                }
+            }
+            // Automatic Phase Detection
+            else if (key == "phase_detection") {
+                config->phase_detection = (value_str == "true" || value_str == "1");
+            } else if (key == "phase_interval") {
+                config->phase_interval = stoull(value_str);
+            } else if (key == "phase_region_bits") {
+                config->phase_region_bits = stoul(value_str);
+            } else if (key == "phase_signature_bits") {
+                config->phase_signature_bits = stoul(value_str);
+            } else if (key == "phase_threshold") {
+                config->phase_threshold = stod(value_str);
+            }
+            // Reuse-Distance Analysis
+            else if (key == "mrc_granularity") {
+                if (value_str == "page") {
+                    config->mrc_page_granularity = true;
+                } else if (value_str == "line") {
+                    config->mrc_page_granularity = false;
+                } else {
+                    cerr << "WARNING: Unknown mrc_granularity '" << value_str << "', using page" << endl;
+                    config->mrc_page_granularity = true;
+                }
+            } else if (key == "mrc_line_size") {
+                config->mrc_line_size = stoul(value_str);
+            } else if (key == "mrc_sampling_rate") {
+                config->mrc_sampling_rate = stod(value_str);
+            } else if (key == "mrc_output") {
+                config->mrc_output = value_str;
+            }
+            // Simulation Parameters
+            else if (key == "trace_lines") {
+                config->trace_lines = stoull(value_str);
+            } else if (key == "max_outstanding") {
+                config->max_outstanding = stoul(value_str);
+            }
+        }
+    }
+
+    file.close();
+
+    for (const auto& name : tier_order) {
+        auto tier = tier_params.find(name);
+        if (tier == tier_params.end()) {
+            cerr << "WARNING: Tier '" << name << "' has no settings, using defaults" << endl;
+            config->tiers.push_back(default_tier_config(name));
+        } else {
+            config->tiers.push_back(tier->second);
+        }
+    }
+
+    for (const auto& name : cache_order) {
+        auto level = cache_params.find(name);
+        if (level == cache_params.end()) {
+            cerr << "WARNING: Cache '" << name << "' has no settings, using defaults" << endl;
+            config->caches.push_back(default_cache_config(name));
+        } else {
+            config->caches.push_back(level->second);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "./../include/flash_geometry.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+FlashGeometry::FlashGeometry(const FlashGeometryConfig& config, uint32_t page_size) : config(config) {
+    this->config.channels = max<uint32_t>(1, config.channels);
+    this->config.dies_per_channel = max<uint32_t>(1, config.dies_per_channel);
+    this->config.planes_per_die = max<uint32_t>(1, min<uint32_t>(32, config.planes_per_die));
+    this->config.pages_per_block = max<uint32_t>(1, config.pages_per_block);
+
+    transfer_cycles = config.channel_bandwidth == 0 ? 0
+        : (page_size + config.channel_bandwidth - 1) / config.channel_bandwidth;
+
+    dies.resize(this->config.channels * this->config.dies_per_channel);
+    channels.resize(this->config.channels);
+    reset();
+}
+
+void FlashGeometry::reset() {
+    for (auto& die : dies) {
+        die = Die{DieOp::IDLE, 0, 0, 0, 0, 0, 0};
+    }
+    for (auto& channel : channels) {
+        channel = Channel{0, 0};
+    }
+    resetStats();
+}
+
+void FlashGeometry::resetStats() {
+    for (auto& die : dies) {
+        die.busy_cycles = 0;
+    }
+    for (auto& channel : channels) {
+        channel.busy_cycles = 0;
+    }
+    array_reads = 0;
+    array_programs = 0;
+    multiplane_joins = 0;
+    read_suspends = 0;
+    die_wait_cycles = 0;
+    channel_wait_cycles = 0;
+}
+
+FlashAddress FlashGeometry::map(uint64_t page) const {
+    FlashAddress location;
+    location.channel = page % config.channels;
+    page /= config.channels;
+    location.die = page % config.dies_per_channel;
+    page /= config.dies_per_channel;
+    location.plane = page % config.planes_per_die;
+    page /= config.planes_per_die;
+    location.page = page % config.pages_per_block;
+    location.block = page / config.pages_per_block;
+    return location;
+}
+
+FlashGeometry::Die& FlashGeometry::dieFor(const FlashAddress& location) {
+    return dies[location.channel * config.dies_per_channel + location.die];
+}
+
+bool FlashGeometry::canJoin(const Die& die, DieOp op, uint32_t plane, uint64_t now) const {
+    // A multi-plane operation accepts other planes shortly after it is issued
+    return die.op == op && now < die.busy_until && (die.plane_mask & (1u << plane)) == 0 &&
+           now <= die.op_start + config.multiplane_window;
+}
+
+uint64_t FlashGeometry::transfer(Channel& channel, uint64_t ready) {
+    uint64_t start = max(ready, channel.busy_until);
+    channel_wait_cycles += start - ready;
+    channel.busy_until = start + transfer_cycles;
+    channel.busy_cycles += transfer_cycles;
+    return channel.busy_until;
+}
+
+uint64_t FlashGeometry::read(uint64_t page, uint64_t now) {
+    FlashAddress location = map(page);
+    Die& die = dieFor(location);
+    uint64_t data_ready;
+
+    if (canJoin(die, DieOp::READ, location.plane, now)) {
+        // Multi-plane read: rides along with the sensing already in progress
+        multiplane_joins++;
+        die.plane_mask |= 1u << location.plane;
+        data_ready = die.busy_until;
+    } else if (die.op == DieOp::PROGRAM && now >= die.op_start && now < die.busy_until &&
+               config.read_suspend && die.suspends < config.max_suspends) {
+        // Read-suspend-on-program: a running program pauses while this read senses,
+        // a bounded number of times so the program still makes progress
+        read_suspends++;
+        die.suspends++;
+        uint64_t pause = config.suspend_latency + config.read_time;
+        uint64_t start = max(now, die.suspend_until);
+        die_wait_cycles += start - now;
+        data_ready = start + pause;
+        die.suspend_until = data_ready;
+        die.busy_until += pause;
+        die.busy_cycles += pause;
+    } else {
+        uint64_t start = max(now, die.busy_until);
+        die_wait_cycles += start - now;
+        die.op = DieOp::READ;
+        die.op_start = start;
+        die.plane_mask = 1u << location.plane;
+        die.busy_until = start + config.read_time;
+        die.busy_cycles += config.read_time;
+        data_ready = die.busy_until;
+    }
+
+    array_reads++;
+    return transfer(channels[location.channel], data_ready);
+}
+
+uint64_t FlashGeometry::program(uint64_t page, uint64_t now) {
+    FlashAddress location = map(page);
+    Die& die = dieFor(location);
+
+    // Data crosses the channel into the die's page register first
+    uint64_t latched = transfer(channels[location.channel], now);
+
+    if (canJoin(die, DieOp::PROGRAM, location.plane, latched)) {
+        multiplane_joins++;
+        die.plane_mask |= 1u << location.plane;
+    } else {
+        uint64_t start = max(latched, die.busy_until);
+        die_wait_cycles += start - latched;
+        die.op = DieOp::PROGRAM;
+        die.op_start = start;
+        die.plane_mask = 1u << location.plane;
+        die.suspends = 0;
+        die.busy_until = start + config.program_time;
+        die.busy_cycles += config.program_time;
+        latched = start;
+    }
+
+    array_programs++;
+    return latched;
+}
+
+void FlashGeometry::printSummary(uint64_t total_pages) const {
+    uint64_t pages_per_plane = total_pages / dies.size() / config.planes_per_die;
+    cout << "Flash geometry: " << config.channels << " channels x "
+         << config.dies_per_channel << " dies x " << config.planes_per_die << " planes, "
+         << (pages_per_plane / config.pages_per_block) << " blocks/plane of "
+         << config.pages_per_block << " pages" << endl;
+    cout << "  tR " << config.read_time << ", tPROG " << config.program_time
+         << ", page transfer " << transfer_cycles << " cycles";
+    if (config.read_suspend) cout << ", read-suspend on (max " << config.max_suspends << " per program)";
+    cout << endl;
+}
+
+void FlashGeometry::printStats(uint64_t elapsed_cycles) const {
+    cout << "\n--- Flash Parallelism ---" << endl;
+    cout << "Geometry:                  " << config.channels << " ch x " << config.dies_per_channel
+         << " dies x " << config.planes_per_die << " planes" << endl;
+    cout << "Array Reads / Programs:    " << array_reads << " / " << array_programs << endl;
+    cout << "Multi-Plane Joins:         " << multiplane_joins << endl;
+    cout << "Read Suspends:             " << read_suspends << endl;
+    cout << "Die Wait:                  " << die_wait_cycles << " cycles" << endl;
+    cout << "Channel Wait:              " << channel_wait_cycles << " cycles" << endl;
+
+    if (elapsed_cycles > 0) {
+        uint64_t busiest = 0, total_busy = 0;
+        for (const auto& die : dies) {
+            busiest = max(busiest, die.busy_cycles);
+            total_busy += die.busy_cycles;
+        }
+        uint64_t bus_busy = 0;
+        for (const auto& channel : channels) {
+            bus_busy += channel.busy_cycles;
+        }
+        cout << "Avg Die Utilization:       " << fixed << setprecision(2)
+             << (double)total_busy / dies.size() / elapsed_cycles * 100.0 << "%" << endl;
+        cout << "Busiest Die Utilization:   " << fixed << setprecision(2)
+             << (double)busiest / elapsed_cycles * 100.0 << "%" << endl;
+        cout << "Avg Channel Utilization:   " << fixed << setprecision(2)
+             << (double)bus_busy / channels.size() / elapsed_cycles * 100.0 << "%" << endl;
+    }
+}
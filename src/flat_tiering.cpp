@@ -0,0 +1,156 @@
+#include "./../include/flat_tiering.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+FlatTiering::FlatTiering(uint64_t dram_pages, uint32_t promote_threshold, uint32_t budget, double hysteresis,
+                         uint32_t cooldown)
+    : dram_pages(dram_pages), promote_threshold(promote_threshold), budget(budget), hysteresis(max(0.0, hysteresis)), cooldown(cooldown) {
+    reset();
+}
+
+void FlatTiering::reset() {
+    pages.clear();
+    dram_resident = 0;
+    epoch = 0;
+    resetStats();
+}
+
+void FlatTiering::resetStats() {
+    epochs = 0;
+    promotions = 0;
+    demotions = 0;
+    budget_deferred = 0;
+    hysteresis_blocked = 0;
+    cooldown_skipped = 0;
+    ping_pongs = 0;
+}
+
+bool FlatTiering::access(uint64_t page) {
+    auto state = pages.find(page);
+    if (state == pages.end()) {
+        // First touch: DRAM while it has free frames, like the kernel's local-node preference
+        bool in_dram = dram_resident < dram_pages;
+        if (in_dram) dram_resident++;
+        state = pages.emplace(page, PageState{0, 0.0f, NEVER_MOVED, in_dram, false}).first;
+    }
+    state->second.epoch_accesses++;
+    return state->second.in_dram;
+}
+
+bool FlatTiering::eligible(const PageState& state) const {
+    return state.last_move == NEVER_MOVED || epoch - state.last_move >= cooldown;
+}
+
+void FlatTiering::move(PageState& state, bool to_dram) {
+    if (state.last_move != NEVER_MOVED && state.last_move_up != to_dram &&
+        epoch - state.last_move < PING_PONG_WINDOW) {
+        ping_pongs++;
+    }
+    state.in_dram = to_dram;
+    state.last_move = epoch;
+    state.last_move_up = to_dram;
+    if (to_dram) {
+        dram_resident++;
+        promotions++;
+    } else {
+        dram_resident--;
+        demotions++;
+    }
+}
+
+void FlatTiering::endEpoch(vector<uint64_t>& promote, vector<uint64_t>& demote) {
+    promote.clear();
+    demote.clear();
+    epochs++;
+
+    // Age the scores and split the candidates by tier
+    vector<pair<float, uint64_t>> hot, cold;
+    for (auto& entry : pages) {
+        PageState& state = entry.second;
+        state.score = state.score * 0.5f + state.epoch_accesses;
+        state.epoch_accesses = 0;
+        if (state.in_dram) {
+            if (eligible(state)) cold.emplace_back(state.score, entry.first);
+        } else if (state.score >= promote_threshold) {
+            if (eligible(state)) {
+                hot.emplace_back(state.score, entry.first);
+            } else {
+                cooldown_skipped++;
+            }
+        }
+    }
+
+    // Only the first `budget` of each ranking can be used this epoch
+    size_t limit = budget == 0 ? max(hot.size(), cold.size()) : budget;
+    size_t hot_ranked = min(hot.size(), limit);
+    size_t cold_ranked = min(cold.size(), limit);
+    partial_sort(hot.begin(), hot.begin() + hot_ranked, hot.end(),
+                 [](const pair<float, uint64_t>& a, const pair<float, uint64_t>& b) { return a.first > b.first; });
+    partial_sort(cold.begin(), cold.begin() + cold_ranked, cold.end());
+
+    uint64_t remaining = budget == 0 ? UINT64_MAX : budget;
+    size_t h = 0, c = 0;
+
+    // Free frames first: a promotion there needs no victim
+    while (h < hot_ranked && dram_resident < dram_pages) {
+        if (remaining == 0) {
+            budget_deferred++;
+            break;
+        }
+        move(pages[hot[h].second], true);
+        promote.push_back(hot[h].second);
+        remaining--;
+        h++;
+    }
+
+    // Exchange the hottest flash pages with the coldest DRAM pages
+    while (h < hot_ranked && c < cold_ranked && dram_resident >= dram_pages) {
+        if (hot[h].first <= cold[c].first * (1.0 + hysteresis)) {
+            hysteresis_blocked++;
+            break;
+        }
+        if (remaining < 2) {
+            budget_deferred++;
+            break;
+        }
+        move(pages[cold[c].second], false);
+        demote.push_back(cold[c].second);
+        move(pages[hot[h].second], true);
+        promote.push_back(hot[h].second);
+        remaining -= 2;
+        h++;
+        c++;
+    }
+
+    epoch++;
+}
+
+void FlatTiering::printSummary() const {
+    cout << "Flat tiering enabled: " << dram_pages << " DRAM pages, budget ";
+    if (budget == 0) {
+        cout << "unlimited";
+    } else {
+        cout << budget << " pages/epoch";
+    }
+    cout << ", hysteresis " << hysteresis << ", cooldown " << cooldown << " epochs" << endl;
+}
+
+void FlatTiering::printStats() const {
+    cout << "DRAM Resident Pages:       " << dram_resident << " / " << dram_pages << endl;
+    cout << "Pages Tracked:             " << pages.size() << " (" << pages.size() - dram_resident
+         << " in flash)" << endl;
+    cout << "Epochs:                    " << epochs << endl;
+    cout << "Promotions / Demotions:    " << promotions << " / " << demotions << endl;
+    if (epochs > 0) {
+        cout << "Migrations per Epoch:      " << fixed << setprecision(2)
+             << (double)(promotions + demotions) / epochs << endl;
+    }
+    cout << "Budget-Limited Epochs:     " << budget_deferred << endl;
+    cout << "Hysteresis-Held Epochs:    " << hysteresis_blocked << endl;
+    cout << "Cooldown-Pinned:           " << cooldown_skipped << " hot candidates" << endl;
+    cout << "Ping-Pong Migrations:      " << ping_pongs << " (reversed within "
+         << PING_PONG_WINDOW << " epochs)" << endl;
+}
@@ -0,0 +1,147 @@
+#include "./../include/hotness_sketch.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+static uint64_t mix64(uint64_t value) {
+    value = (value ^ (value >> 33)) * 0xFF51AFD7ED558CCDULL;
+    value = (value ^ (value >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+    return value ^ (value >> 33);
+}
+
+HotnessSketch::HotnessSketch(uint32_t width, uint32_t depth, bool conservative, uint64_t half_life, uint32_t top_k)
+    : width(max<uint32_t>(1, width)), depth(max<uint32_t>(1, depth)), conservative(conservative),
+      half_life(half_life), top_k(top_k) {
+    counters.assign((size_t)this->width * this->depth, 0);
+    for (uint32_t row = 0; row < this->depth; row++) {
+        seeds.push_back(mix64(0x9E3779B97F4A7C15ULL * (row + 1)));
+    }
+    top.reserve(top_k);
+    reset();
+}
+
+void HotnessSketch::reset() {
+    fill(counters.begin(), counters.end(), 0);
+    top.clear();
+    top_index.clear();
+    top_min = 0;
+    updates = 0;
+    agings = 0;
+}
+
+uint32_t HotnessSketch::column(uint64_t key, uint32_t row) const {
+    return mix64(key ^ seeds[row]) % width;
+}
+
+uint32_t HotnessSketch::sketchEstimate(uint64_t key) const {
+    uint32_t minimum = UINT32_MAX;
+    for (uint32_t row = 0; row < depth; row++) {
+        minimum = min(minimum, counters[(size_t)row * width + column(key, row)]);
+    }
+    return minimum;
+}
+
+uint32_t HotnessSketch::increment(uint64_t key) {
+    uint32_t estimate;
+    if (conservative) {
+        // Conservative update: only raise counters that are at the current minimum
+        estimate = sketchEstimate(key) + 1;
+        for (uint32_t row = 0; row < depth; row++) {
+            uint32_t& counter = counters[(size_t)row * width + column(key, row)];
+            if (counter < estimate) counter = estimate;
+        }
+    } else {
+        estimate = UINT32_MAX;
+        for (uint32_t row = 0; row < depth; row++) {
+            uint32_t& counter = counters[(size_t)row * width + column(key, row)];
+            counter++;
+            estimate = min(estimate, counter);
+        }
+    }
+
+    if (top_k > 0) updateTopK(key, estimate);
+
+    updates++;
+    if (half_life > 0 && updates % half_life == 0) age();
+
+    return this->estimate(key);
+}
+
+void HotnessSketch::updateTopK(uint64_t key, uint32_t estimate) {
+    auto member = top_index.find(key);
+    if (member != top_index.end()) {
+        top[member->second].count++;
+        return;
+    }
+
+    if (top.size() < top_k) {
+        top_index[key] = top.size();
+        top.push_back(TopEntry{key, estimate});
+        if (top.size() == top_k) {
+            top_min = UINT32_MAX;
+            for (const auto& entry : top) top_min = min(top_min, entry.count);
+        }
+        return;
+    }
+
+    // Space-saving: a newcomer displaces the smallest entry once it overtakes it
+    if (estimate <= top_min) return;
+
+    uint32_t victim = 0;
+    for (uint32_t i = 1; i < top.size(); i++) {
+        if (top[i].count < top[victim].count) victim = i;
+    }
+    if (estimate <= top[victim].count) {
+        top_min = top[victim].count;
+        return;
+    }
+
+    top_index.erase(top[victim].key);
+    top_index[key] = victim;
+    top[victim] = TopEntry{key, estimate};
+
+    top_min = UINT32_MAX;
+    for (const auto& entry : top) top_min = min(top_min, entry.count);
+}
+
+void HotnessSketch::age() {
+    agings++;
+    for (auto& counter : counters) counter >>= 1;
+    for (auto& entry : top) entry.count >>= 1;
+    top_min >>= 1;
+}
+
+uint32_t HotnessSketch::estimate(uint64_t key) const {
+    auto member = top_index.find(key);
+    if (member != top_index.end()) return top[member->second].count;
+    return sketchEstimate(key);
+}
+
+size_t HotnessSketch::memoryBytes() const {
+    return counters.size() * sizeof(uint32_t) + top_k * (sizeof(TopEntry) + 2 * sizeof(uint64_t));
+}
+
+void HotnessSketch::printStats() const {
+    cout << "Sketch:                    " << depth << " x " << width
+         << (conservative ? " count-min (conservative update)" : " count-min") << endl;
+    cout << "Tracking Memory:           " << memoryBytes() << " bytes (fixed)" << endl;
+    if (half_life > 0) {
+        cout << "Decay Half-Life:           " << half_life << " accesses (" << agings << " halvings)" << endl;
+    } else {
+        cout << "Decay Half-Life:           none (lifetime counts)" << endl;
+    }
+
+    if (top.empty()) return;
+
+    vector<TopEntry> ranked(top);
+    sort(ranked.begin(), ranked.end(),
+         [](const TopEntry& a, const TopEntry& b) { return a.count > b.count; });
+
+    size_t shown = min<size_t>(ranked.size(), 10);
+    cout << "Top " << shown << " of " << top_k << " Hottest Addresses:" << endl;
+    for (size_t i = 0; i < shown; i++) {
+        cout << "  0x" << hex << ranked[i].key << dec << ": " << ranked[i].count << endl;
+    }
+}
@@ -0,0 +1,152 @@
+#include "./../include/hybridmemsim.h"
+#include "./../include/hybridmemsim_c.h"
+#include <exception>
+
+using namespace std;
+
+namespace hybridmemsim {
+
+static Config quietConfig(Config config) {
+    config.quiet = true;
+    return config;
+}
+
+MemorySystem::MemorySystem(Config config) : simulator(quietConfig(config)), now(0), sent(0) {}
+
+void MemorySystem::send(const Request& request) {
+    Request queued_request = request;
+    if (queued_request.issue_cycle < now) queued_request.issue_cycle = now;
+    queued.push(QueuedRequest{queued_request, sent++});
+}
+
+void MemorySystem::send(uint64_t tag, uint64_t address, bool is_write, uint64_t issue_cycle) {
+    send(Request{tag, address, is_write, issue_cycle});
+}
+
+void MemorySystem::tick(uint64_t cycles) {
+    now += cycles;
+
+    // The model only moves forward in time, so requests are simulated in issue order
+    while (!queued.empty() && queued.top().request.issue_cycle <= now) {
+        const Request& request = queued.top().request;
+        uint64_t latency = simulator.accessAt(request.is_write ? 'W' : 'R', request.address, request.issue_cycle);
+        pending.push(Completion{request.tag, request.address, request.is_write, request.issue_cycle,
+                                request.issue_cycle + latency});
+        queued.pop();
+    }
+
+    while (!pending.empty() && pending.top().complete_cycle <= now) {
+        if (callback) {
+            callback(pending.top());
+        } else {
+            completed.push_back(pending.top());
+        }
+        pending.pop();
+    }
+}
+
+void MemorySystem::setCompletionCallback(CompletionCallback callback) {
+    this->callback = callback;
+    // Anything already retired goes out through the new callback
+    while (this->callback && !completed.empty()) {
+        this->callback(completed.front());
+        completed.pop_front();
+    }
+}
+
+bool MemorySystem::pollCompletion(Completion& completion) {
+    if (completed.empty()) return false;
+    completion = completed.front();
+    completed.pop_front();
+    return true;
+}
+
+} // namespace hybridmemsim
+
+// ========== C binding ==========
+
+struct hms_system {
+    hybridmemsim::MemorySystem system;
+
+    explicit hms_system(const Config& config) : system(config) {}
+};
+
+static hms_completion toC(const hybridmemsim::Completion& completion) {
+    return hms_completion{completion.tag, completion.address, completion.is_write ? 1 : 0,
+                          completion.issue_cycle, completion.complete_cycle};
+}
+
+extern "C" {
+
+hms_system* hms_create(const char* config_path) {
+    // No exception may cross into C callers; a malformed value fails the create
+    try {
+        Config config;
+        if (read_config(config_path == nullptr ? "" : config_path, &config)) return nullptr;
+        return new hms_system(config);
+    } catch (const exception&) {
+        return nullptr;
+    }
+}
+
+void hms_destroy(hms_system* system) {
+    delete system;
+}
+
+void hms_send(hms_system* system, uint64_t tag, uint64_t address, int is_write, uint64_t issue_cycle) {
+    system->system.send(tag, address, is_write != 0, issue_cycle);
+}
+
+void hms_tick(hms_system* system, uint64_t cycles) {
+    system->system.tick(cycles);
+}
+
+uint64_t hms_cycle(const hms_system* system) {
+    return system->system.cycle();
+}
+
+uint64_t hms_in_flight(const hms_system* system) {
+    return system->system.inFlight();
+}
+
+void hms_set_callback(hms_system* system, hms_completion_fn callback, void* user_data) {
+    if (callback == nullptr) {
+        system->system.setCompletionCallback(nullptr);
+        return;
+    }
+    system->system.setCompletionCallback([callback, user_data](const hybridmemsim::Completion& completion) {
+        hms_completion c_completion = toC(completion);
+        callback(&c_completion, user_data);
+    });
+}
+
+int hms_poll(hms_system* system, hms_completion* completion) {
+    hybridmemsim::Completion next;
+    if (!system->system.pollCompletion(next)) return 0;
+    *completion = toC(next);
+    return 1;
+}
+
+void hms_get_stats(const hms_system* system, hms_stats* stats) {
+    StatsSnapshot snapshot = system->system.stats();
+    stats->total_accesses = snapshot.total_accesses;
+    stats->total_latency = snapshot.total_latency;
+    stats->current_cycle = snapshot.current_cycle;
+    stats->row_hits = snapshot.row_hits;
+    stats->row_misses = snapshot.row_misses;
+    stats->row_empty_misses = snapshot.row_empty_misses;
+    stats->row_conflict_misses = snapshot.row_conflict_misses;
+    stats->refresh_cycles = snapshot.refresh_cycles;
+    stats->dram_cache_hits = snapshot.dram_cache_hits;
+    stats->dram_cache_misses = snapshot.dram_cache_misses;
+    stats->flash_reads = snapshot.flash_reads;
+    stats->flash_writes = snapshot.flash_writes;
+    stats->cache_promotions = snapshot.cache_promotions;
+    stats->cache_evictions = snapshot.cache_evictions;
+    stats->prefetches_issued = snapshot.prefetches_issued;
+    stats->prefetch_hits = snapshot.prefetch_hits;
+    stats->rejected_accesses = snapshot.rejected_accesses;
+    stats->refresh_commands = snapshot.refresh_commands;
+}
+
+} // extern "C"
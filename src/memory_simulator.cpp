@@ -4,12 +4,106 @@
 #include <iomanip>
 #include <random>
 #include <ctime>
+#include <cstdlib>
 
 #define initial_value 0 
 
 
 using namespace std;
 
+static const char* pagePolicyName(PagePolicy policy) {
+    switch (policy) {
+        case PagePolicy::OPEN:     return "open";
+        case PagePolicy::CLOSED:   return "closed";
+        case PagePolicy::TIMEOUT:  return "timeout";
+        case PagePolicy::ADAPTIVE: return "adaptive";
+    }
+    return "unknown";
+}
+
+// Parses "<op> <hex address>"; returns false for malformed lines
+static bool parseTraceLine(const string& line, char& operation, uint64_t& address,
+                           double* compress_ratio = nullptr) {
+    stringstream ss(line);
+    ss >> operation >> hex >> address;
+    if (ss.fail()) return false;
+
+    // Optional annotation: "cr=<ratio>" gives the page's compressibility
+    if (compress_ratio != nullptr) {
+        *compress_ratio = 0.0;
+        string token;
+        while (ss >> token) {
+            if (token.compare(0, 3, "cr=") == 0) *compress_ratio = atof(token.c_str() + 3);
+        }
+    }
+    return true;
+}
+
+static StatsSnapshot snapshotDelta(const StatsSnapshot& end, const StatsSnapshot& start) {
+    StatsSnapshot delta;
+    delta.total_accesses = end.total_accesses - start.total_accesses;
+    delta.rejected_accesses = end.rejected_accesses - start.rejected_accesses;
+    delta.total_latency = end.total_latency - start.total_latency;
+    delta.current_cycle = end.current_cycle - start.current_cycle;
+    delta.row_hits = end.row_hits - start.row_hits;
+    delta.row_misses = end.row_misses - start.row_misses;
+    delta.row_empty_misses = end.row_empty_misses - start.row_empty_misses;
+    delta.row_conflict_misses = end.row_conflict_misses - start.row_conflict_misses;
+    delta.refresh_cycles = end.refresh_cycles - start.refresh_cycles;
+    delta.refresh_commands = end.refresh_commands - start.refresh_commands;
+    delta.dram_cache_hits = end.dram_cache_hits - start.dram_cache_hits;
+    delta.dram_cache_misses = end.dram_cache_misses - start.dram_cache_misses;
+    delta.flash_reads = end.flash_reads - start.flash_reads;
+    delta.flash_writes = end.flash_writes - start.flash_writes;
+    delta.cache_promotions = end.cache_promotions - start.cache_promotions;
+    delta.cache_evictions = end.cache_evictions - start.cache_evictions;
+    delta.prefetches_issued = end.prefetches_issued - start.prefetches_issued;
+    delta.prefetch_hits = end.prefetch_hits - start.prefetch_hits;
+    return delta;
+}
+
+static void addSnapshot(StatsSnapshot& total, const StatsSnapshot& delta) {
+    total.total_accesses += delta.total_accesses;
+    total.rejected_accesses += delta.rejected_accesses;
+    total.total_latency += delta.total_latency;
+    total.current_cycle += delta.current_cycle;
+    total.row_hits += delta.row_hits;
+    total.row_misses += delta.row_misses;
+    total.row_empty_misses += delta.row_empty_misses;
+    total.row_conflict_misses += delta.row_conflict_misses;
+    total.refresh_cycles += delta.refresh_cycles;
+    total.refresh_commands += delta.refresh_commands;
+    total.dram_cache_hits += delta.dram_cache_hits;
+    total.dram_cache_misses += delta.dram_cache_misses;
+    total.flash_reads += delta.flash_reads;
+    total.flash_writes += delta.flash_writes;
+    total.cache_promotions += delta.cache_promotions;
+    total.cache_evictions += delta.cache_evictions;
+    total.prefetches_issued += delta.prefetches_issued;
+    total.prefetch_hits += delta.prefetch_hits;
+}
+
+static void printPhaseLine(const string& label, const StatsSnapshot& stats, bool hybrid) {
+    cout << "  " << label << ":" << string(label.size() < 24 ? 24 - label.size() : 1, ' ')
+         << stats.total_accesses << " accesses, " << stats.current_cycle << " cycles";
+    if (stats.total_accesses > 0) {
+        cout << ", avg " << fixed << setprecision(2) << (double)stats.total_latency / stats.total_accesses;
+    }
+    uint64_t row_accesses = stats.row_hits + stats.row_misses;
+    if (row_accesses > 0) {
+        cout << ", row hits " << fixed << setprecision(2) << (double)stats.row_hits / row_accesses * 100.0 << "%";
+    }
+    if (hybrid) {
+        uint64_t lookups = stats.dram_cache_hits + stats.dram_cache_misses;
+        if (lookups > 0) {
+            cout << ", DRAM hits " << fixed << setprecision(2)
+                 << (double)stats.dram_cache_hits / lookups * 100.0 << "%";
+        }
+        cout << ", flash R/W " << stats.flash_reads << "/" << stats.flash_writes;
+    }
+    cout << endl;
+}
+
 //class MemorySimulator{
 
 //public:
@@ -23,41 +117,151 @@ using namespace std;
             banks.emplace_back(config.bank_size, 1024);
         }
 
+        // Refresh timing: FGR divides tREFI and shortens tRFC (DDR4-style ratios 1 : 0.74 : 0.46);
+        // a per-bank command takes about half of an all-bank one
+        uint32_t granularity = (config.refresh_granularity == 2 || config.refresh_granularity == 4)
+                               ? config.refresh_granularity : 1;
+        double trfc_scale = granularity == 4 ? 0.46 : (granularity == 2 ? 0.74 : 1.0);
+        if (config.refresh_mode == RefreshMode::PER_BANK) trfc_scale *= 0.5;
+        uint32_t base_trfc = config.refresh_latency > 0 ? config.refresh_latency : REFRESH_LATENCY;
+        refresh_period = max<uint64_t>(1, config.refresh_interval / granularity);
+        refresh_duration = max<uint32_t>(1, (uint32_t)(base_trfc * trfc_scale));
+        sim_config.refresh_granularity = granularity;
+
         // Initialize DRAM statistics
         total_accesses = 0;
+        rejected_accesses = 0;
         row_hits = 0;
         row_misses = 0;
+        row_empty_misses = 0;
+        row_conflict_misses = 0;
+        policy_precharges = 0;
+        premature_precharges = 0;
+        bank_busy_cycles = 0;
         total_latency = 0;
+        service_latency_base = 0;
         refresh_cycles = 0;
+        refresh_commands = 0;
+        current_cycle = 0;
+        outstanding = decltype(outstanding)();
+
+        // Initialize the N-tier hierarchy; it supersedes the DRAM+Flash pair
+        tiers = nullptr;
+        if (!config.tiers.empty()) {
+            tiers = new TierHierarchy(config.tiers, config.flash_page_size, config.tier_access_size,
+                                      config.tier_promote_margin, config.tier_cooldown);
+            if (!config.quiet) tiers->printSummary();
+        }
+
+        // Initialize the on-chip cache filter
+        caches = nullptr;
+        if (!config.caches.empty()) {
+            caches = new CacheHierarchy(config.caches);
+            pending_accesses.reserve(CACHE_FILTER_BATCH);
+            if (!config.quiet) caches->printSummary();
+        }
+
+        phase_detector = nullptr;
+        if (config.phase_detection) {
+            phase_detector = new PhaseDetector(config.phase_interval, config.phase_region_bits,
+                                               config.phase_signature_bits, config.phase_threshold);
+        }
 
         // Initialize flash/hybrid memory
-        hybrid_mode = config.enable_flash;
+        hybrid_mode = config.enable_flash && tiers == nullptr;
         if (hybrid_mode) {
             flash = new FlashMemory(config.flash_capacity, config.flash_page_size);
             flash_reads = 0;
             flash_writes = 0;
             cache_promotions = 0;
             cache_evictions = 0;
+            dram_cache_capacity_evictions = 0;
             dram_cache_hits = 0;
             dram_cache_misses = 0;
             dram_access_latency = 0;
             flash_access_latency = 0;
             cache_overhead = 0;
-            cout << "Hybrid mode enabled (DRAM-as-cache model): Flash memory initialized with "
-                 << config.flash_capacity << " bytes ("
-                 << (config.flash_capacity / config.flash_page_size) << " pages)" << endl;
+            if (!config.quiet) {
+                cout << "Hybrid mode enabled (DRAM-as-cache model): Flash memory initialized with "
+                     << config.flash_capacity << " bytes ("
+                     << (config.flash_capacity / config.flash_page_size) << " pages)" << endl;
+            }
+
+            // The sketch bounds hotness tracking, so the cached set is bounded too
+            dram_cache_capacity = config.dram_cache_entries;
+            if (dram_cache_capacity == 0 && config.hotness_sketch) {
+                dram_cache_capacity = (uint64_t)banks.size() * config.bank_size * 1024 / DRAM_CACHE_LINE_SIZE;
+            }
+
+            hotness = nullptr;
+            if (config.hotness_sketch) {
+                hotness = new HotnessSketch(config.sketch_width, config.sketch_depth, config.sketch_conservative,
+                                            config.hotness_half_life, config.hotness_topk);
+                if (!config.quiet) {
+                    cout << "Hotness sketch enabled: " << hotness->memoryBytes() << " bytes, half-life "
+                         << config.hotness_half_life << " accesses" << endl;
+                }
+            }
+
+            flat_tiers = nullptr;
+            if (config.hybrid_model == HybridModel::FLAT) {
+                uint64_t capacity = config.flat_dram_capacity > 0 ? config.flat_dram_capacity
+                                    : (uint64_t)banks.size() * config.bank_size * 1024;
+                flat_tiers = new FlatTiering(capacity / config.flash_page_size, HOT_DATA_THRESHOLD,
+                                             config.migration_budget, config.migration_hysteresis,
+                                             config.migration_cooldown);
+                if (!config.quiet) flat_tiers->printSummary();
+            }
+
+            compressed_dram = nullptr;
+            if (config.dram_compression && flat_tiers == nullptr) {
+                uint64_t capacity = config.compression_capacity > 0 ? config.compression_capacity
+                                    : (uint64_t)banks.size() * config.bank_size * 1024;
+                compressed_dram = new CompressedDRAM(capacity, config.flash_page_size, config.compression_mix,
+                                                     config.compression_latency, config.decompression_latency);
+                if (!config.quiet) compressed_dram->printSummary();
+            }
+
+            flash_timing = nullptr;
+            flash_busy_until = 0;
+            flash_queue_cycles = 0;
+            if (config.flash_geometry.enabled) {
+                flash_timing = new FlashGeometry(config.flash_geometry, config.flash_page_size);
+                if (!config.quiet) flash_timing->printSummary(flash->pages.size());
+            }
+
+            // The prefetch engine stages pages for the DRAM cache, so it only runs in cache mode
+            prefetcher = flat_tiers == nullptr ? Prefetcher::create(config.prefetcher, config.prefetch_degree) : nullptr;
+            if (prefetcher != nullptr && !config.quiet) {
+                cout << "Prefetch engine enabled: " << prefetcher->name() << " (degree "
+                     << config.prefetch_degree << ", budget " << config.prefetch_budget
+                     << " pages / " << config.prefetch_window << " cycles)" << endl;
+            }
         } else {
             flash = nullptr;
+            dram_cache_capacity = 0;
+            hotness = nullptr;
+            compressed_dram = nullptr;
+            flat_tiers = nullptr;
+            flash_timing = nullptr;
+            flash_busy_until = 0;
+            flash_queue_cycles = 0;
+            prefetcher = nullptr;
             flash_reads = 0;
             flash_writes = 0;
             cache_promotions = 0;
             cache_evictions = 0;
+            dram_cache_capacity_evictions = 0;
             dram_cache_hits = 0;
             dram_cache_misses = 0;
             dram_access_latency = 0;
             flash_access_latency = 0;
             cache_overhead = 0;
         }
+        resetPrefetchState();
+        resetMigrationState();
+        resetRefreshState();
+        resetPhaseState();
     }
 
     MemorySimulator::~MemorySimulator() {
@@ -66,6 +270,38 @@ using namespace std;
             delete flash;
             flash = nullptr;
         }
+        if (hotness != nullptr) {
+            delete hotness;
+            hotness = nullptr;
+        }
+        if (compressed_dram != nullptr) {
+            delete compressed_dram;
+            compressed_dram = nullptr;
+        }
+        if (flat_tiers != nullptr) {
+            delete flat_tiers;
+            flat_tiers = nullptr;
+        }
+        if (flash_timing != nullptr) {
+            delete flash_timing;
+            flash_timing = nullptr;
+        }
+        if (prefetcher != nullptr) {
+            delete prefetcher;
+            prefetcher = nullptr;
+        }
+        if (tiers != nullptr) {
+            delete tiers;
+            tiers = nullptr;
+        }
+        if (caches != nullptr) {
+            delete caches;
+            caches = nullptr;
+        }
+        if (phase_detector != nullptr) {
+            delete phase_detector;
+            phase_detector = nullptr;
+        }
     }
 
     void MemorySimulator::initialize() {
@@ -78,7 +314,7 @@ using namespace std;
                 fill(row.begin(), row.end(), 0);
             }
             // Set no row as active initially
-            banks[i].active_row = -1;
+            banks[i].resetRowBuffer();
 
             cout << "  Bank " << i << ": " << banks[i].rows.size()
                  << " rows x " << banks[i].rows[0].size() << " columns initialized" << endl;
@@ -86,10 +322,25 @@ using namespace std;
 
         // Initialize statistics
         total_accesses = 0;
+        rejected_accesses = 0;
         row_hits = 0;
         row_misses = 0;
+        row_empty_misses = 0;
+        row_conflict_misses = 0;
+        policy_precharges = 0;
+        premature_precharges = 0;
+        bank_busy_cycles = 0;
         total_latency = 0;
+        service_latency_base = 0;
         refresh_cycles = 0;
+        refresh_commands = 0;
+        current_cycle = 0;
+        outstanding = decltype(outstanding)();
+        resetRefreshState();
+
+        if (tiers != nullptr) tiers->reset();
+        if (caches != nullptr) caches->reset();
+        pending_accesses.clear();
 
         cout << "DRAM initialization complete!" << endl;
         cout << "Total capacity: " << banks.size() << " banks x "
@@ -112,17 +363,26 @@ using namespace std;
             // Clear tracking maps
             access_frequency.clear();
             data_in_dram_cache.clear();
+            dram_cache_lru.clear();
+            if (hotness != nullptr) hotness->reset();
+            if (compressed_dram != nullptr) compressed_dram->reset();
 
             // Reset flash statistics
             flash_reads = 0;
             flash_writes = 0;
             cache_promotions = 0;
             cache_evictions = 0;
+            dram_cache_capacity_evictions = 0;
             dram_cache_hits = 0;
             dram_cache_misses = 0;
             dram_access_latency = 0;
             flash_access_latency = 0;
             cache_overhead = 0;
+            resetPrefetchState();
+            resetMigrationState();
+            if (flash_timing != nullptr) flash_timing->reset();
+            flash_busy_until = 0;
+            flash_queue_cycles = 0;
 
             cout << "Flash initialization complete!" << endl;
             cout << "Flash capacity: " << flash->total_capacity << " bytes ("
@@ -130,6 +390,7 @@ using namespace std;
                  << flash->page_size << " bytes/page)" << endl;
             cout << "\nHybrid memory system ready!" << endl;
         }
+        resetPhaseState();
     }
 
     void MemorySimulator::clear() {
@@ -140,15 +401,31 @@ using namespace std;
                 fill(row.begin(), row.end(), 0);
             }
             // Reset active row indicator
-            bank.active_row = -1;
+            bank.resetRowBuffer();
         }
 
         // Reset DRAM statistics
         total_accesses = 0;
+        rejected_accesses = 0;
         row_hits = 0;
         row_misses = 0;
+        row_empty_misses = 0;
+        row_conflict_misses = 0;
+        policy_precharges = 0;
+        premature_precharges = 0;
+        bank_busy_cycles = 0;
         total_latency = 0;
+        service_latency_base = 0;
         refresh_cycles = 0;
+        refresh_commands = 0;
+        current_cycle = 0;
+        outstanding = decltype(outstanding)();
+        resetRefreshState();
+
+        // Clear the N-tier hierarchy and cache filter
+        if (tiers != nullptr) tiers->reset();
+        if (caches != nullptr) caches->reset();
+        pending_accesses.clear();
 
         // Clear Flash memory (if hybrid mode)
         if (hybrid_mode && flash != nullptr) {
@@ -162,18 +439,28 @@ using namespace std;
             // Clear tracking maps
             access_frequency.clear();
             data_in_dram_cache.clear();
+            dram_cache_lru.clear();
+            if (hotness != nullptr) hotness->reset();
+            if (compressed_dram != nullptr) compressed_dram->reset();
 
             // Reset flash statistics
             flash_reads = 0;
             flash_writes = 0;
             cache_promotions = 0;
             cache_evictions = 0;
+            dram_cache_capacity_evictions = 0;
             dram_cache_hits = 0;
             dram_cache_misses = 0;
             dram_access_latency = 0;
             flash_access_latency = 0;
             cache_overhead = 0;
+            resetPrefetchState();
+            resetMigrationState();
+            if (flash_timing != nullptr) flash_timing->reset();
+            flash_busy_until = 0;
+            flash_queue_cycles = 0;
         }
+        resetPhaseState();
     }
 
 
@@ -210,205 +497,989 @@ using namespace std;
             
             // Skip empty lines and comments
             if (line.empty() || line[0] == '#') continue;
-            
+
+            // Statistics markers apply once every earlier access has been simulated
+            if (line[0] == '@') {
+                drainAccesses();
+                if (handleTraceMarker(line, line_num)) continue;
+
+                // @roi end: the measured region is over, so every total stays as it was there
+                cout << "Region of interest ended at line " << line_num
+                     << "; the rest of the trace is not simulated" << endl;
+                break;
+            }
+
             // Parse line: operation address
             char operation;
             uint64_t address;
-            
-            stringstream ss(line);
-            ss >> operation >> hex >> address;
-            
-            if (ss.fail()) {
+
+            double compress_ratio;
+            if (!parseTraceLine(line, operation, address, &compress_ratio)) {
                 cerr << "Warning: Invalid trace format at line " << line_num << endl;
                 continue;
             }
-            
-            // Process the memory access
-            processAccess(operation, address);
-            
-            // Simulate periodic refresh (every 64000 cycles as per config)
-            if (total_accesses % 8192 == 0 && total_accesses > 0) {
-                performRefresh();
+            if (compress_ratio > 0.0 && compressed_dram != nullptr) {
+                compressed_dram->annotate(address / sim_config.flash_page_size, compress_ratio);
             }
+
+            // Process the memory access (refresh is scheduled from simulated time)
+            submitAccess(operation, address);
         }
-        
+
+        // Flush the last partial filter batch, then settle refreshes that fell due after it
+        drainAccesses();
+        waitForOutstanding();
+        performRefresh();
+        finishPhases();
+
         trace.close();
         cout << "Trace processing complete. Total accesses: " << total_accesses << endl;
     }
 
+    void MemorySimulator::profileReuse() {
+        cout << "Starting reuse-distance analysis..." << endl;
+
+        string trace_file;
+        cout << "Enter path to trace file: ";
+        getline(cin, trace_file);
+
+        ifstream trace(trace_file);
+        if (!trace.is_open()) {
+            cerr << "Error: Could not open trace file '" << trace_file << "'" << endl;
+            return;
+        }
+
+        uint32_t block_size = sim_config.mrc_page_granularity ? sim_config.flash_page_size
+                                                              : sim_config.mrc_line_size;
+        ReuseDistanceProfiler profiler(block_size, sim_config.mrc_sampling_rate);
+
+        string line;
+        int line_num = 0;
+        while (getline(trace, line)) {
+            line_num++;
+            if (line.empty() || line[0] == '#' || line[0] == '@') continue;
+
+            char operation;
+            uint64_t address;
+            if (!parseTraceLine(line, operation, address)) {
+                cerr << "Warning: Invalid trace format at line " << line_num << endl;
+                continue;
+            }
+            profiler.access(address);
+        }
+        trace.close();
+
+        // Highlight the DRAM tier this configuration would simulate
+        uint64_t dram_bytes = banks.empty() ? 0 : banks.size() * banks[0].rows.size() * banks[0].rows[0].size();
+        profiler.printCurve(dram_bytes);
+
+        if (!sim_config.mrc_output.empty()) {
+            if (profiler.writeCurve(sim_config.mrc_output)) {
+                cout << "Full miss-ratio curve written to " << sim_config.mrc_output << endl;
+            } else {
+                cerr << "Error: Could not write miss-ratio curve to '" << sim_config.mrc_output << "'" << endl;
+            }
+        }
+    }
+
     void MemorySimulator::processAccess(char operation, uint64_t address) {
+        if (sim_config.max_outstanding <= 1) {
+            // Accesses are serviced back-to-back, so time advances by each access's latency
+            current_cycle += serviceAccess(operation, address);
+        } else {
+            // Up to max_outstanding accesses overlap; once the window is full the next
+            // one issues when the earliest in flight completes
+            while (!outstanding.empty() && outstanding.top() <= current_cycle) outstanding.pop();
+            if (outstanding.size() >= sim_config.max_outstanding) {
+                current_cycle = outstanding.top();
+                outstanding.pop();
+            }
+            outstanding.push(current_cycle + serviceAccess(operation, address));
+        }
+        observePhase(address);
+    }
+
+    void MemorySimulator::observePhase(uint64_t address) {
+        if (phase_detector == nullptr) return;
+        int phase = phase_detector->observe(address);
+        if (phase >= 0) recordDetectedPhase(phase);
+    }
+
+    void MemorySimulator::waitForOutstanding() {
+        while (!outstanding.empty()) {
+            current_cycle = max(current_cycle, outstanding.top());
+            outstanding.pop();
+        }
+    }
+
+    void MemorySimulator::submitAccess(char operation, uint64_t address) {
+        if (caches == nullptr) {
+            processAccess(operation, address);
+            return;
+        }
+
+        // Core accesses are filtered in batches; only misses and writebacks reach memory
+        pending_accesses.push_back(CacheRequest{address, operation});
+        if (pending_accesses.size() >= CACHE_FILTER_BATCH) drainAccesses();
+    }
+
+    void MemorySimulator::drainAccesses() {
+        if (caches == nullptr || pending_accesses.empty()) return;
+
+        memory_requests.clear();
+        caches->accessBatch(pending_accesses.data(), pending_accesses.size(), memory_requests);
+        pending_accesses.clear();
+        for (const CacheRequest& request : memory_requests) {
+            processAccess(request.operation, request.address);
+        }
+    }
+
+    bool MemorySimulator::handleTraceMarker(const string& line, int line_num) {
+        // @reset | @snapshot [label] | @phase <label> | @roi begin | @roi end
+        // Returns false at @roi end, which ends the run
+        stringstream ss(line.substr(1));
+        string command, argument;
+        ss >> command;
+        getline(ss >> ws, argument);
+
+        if (command == "reset") {
+            resetStats();
+        } else if (command == "snapshot") {
+            StatsSnapshot snapshot = snapshotStats();
+            snapshot.current_cycle -= stats_start_cycle;
+            string label = argument.empty() ? "snapshot " + to_string(trace_snapshots.size() + 1) : argument;
+            trace_snapshots.push_back(PhaseRecord{label, 1, snapshot});
+        } else if (command == "phase") {
+            closeTracePhase();
+            openTracePhase(argument.empty() ? "phase " + to_string(trace_phases.size() + 1) : argument);
+        } else if (command == "roi" && argument == "begin") {
+            // Everything before the region of interest is warm-up
+            closeTracePhase();
+            resetStats();
+            openTracePhase("roi");
+        } else if (command == "roi" && argument == "end") {
+            closeTracePhase();
+            return false;
+        } else {
+            cerr << "Warning: Unknown trace marker '" << line << "' at line " << line_num << endl;
+        }
+        return true;
+    }
+
+    void MemorySimulator::openTracePhase(const string& label) {
+        trace_phase_open = true;
+        trace_phase_label = label;
+        trace_phase_start = snapshotStats();
+    }
+
+    void MemorySimulator::closeTracePhase() {
+        if (!trace_phase_open) return;
+        trace_phases.push_back(PhaseRecord{trace_phase_label, 1, snapshotDelta(snapshotStats(), trace_phase_start)});
+        trace_phase_open = false;
+    }
+
+    void MemorySimulator::recordDetectedPhase(int phase) {
+        StatsSnapshot now = snapshotStats();
+        while (detected_phases.size() <= (size_t)phase) {
+            detected_phases.push_back(PhaseRecord{"phase " + to_string(detected_phases.size()), 0, StatsSnapshot{}});
+        }
+        detected_phases[phase].intervals++;
+        addSnapshot(detected_phases[phase].stats, snapshotDelta(now, interval_start));
+        interval_start = now;
+    }
+
+    void MemorySimulator::finishPhases() {
+        closeTracePhase();
+        if (phase_detector != nullptr) {
+            int phase = phase_detector->finish();
+            if (phase >= 0) recordDetectedPhase(phase);
+        }
+    }
+
+    void MemorySimulator::resetPhaseState() {
+        stats_start_cycle = current_cycle;
+        stats_resets = 0;
+        trace_phases.clear();
+        trace_snapshots.clear();
+        trace_phase_open = false;
+        trace_phase_label.clear();
+        detected_phases.clear();
+        if (phase_detector != nullptr) phase_detector->reset();
+        interval_start = snapshotStats();
+    }
+
+    void MemorySimulator::resetStats() {
+        // Counters only: row buffers, cached pages, cache contents and timelines stay warm
+        StatsSnapshot phase_so_far = snapshotDelta(snapshotStats(), trace_phase_start);
+        StatsSnapshot interval_so_far = snapshotDelta(snapshotStats(), interval_start);
+
+        total_accesses = 0;
+        rejected_accesses = 0;
+        row_hits = 0;
+        row_misses = 0;
+        row_empty_misses = 0;
+        row_conflict_misses = 0;
+        policy_precharges = 0;
+        premature_precharges = 0;
+        bank_busy_cycles = 0;
+        total_latency = 0;
+        service_latency_base = 0;
+        refresh_cycles = 0;
+        refresh_commands = 0;
+        refreshes_hidden = 0;
+        refreshes_forced = 0;
+        refresh_stall_cycles = 0;
+        max_refresh_backlog = 0;
+        for (auto& bank : banks) {
+            bank.refreshes = 0;
+            bank.refresh_stall_cycles = 0;
+        }
+
+        flash_reads = 0;
+        flash_writes = 0;
+        cache_promotions = 0;
+        cache_evictions = 0;
+        dram_cache_capacity_evictions = 0;
+        dram_cache_hits = 0;
+        dram_cache_misses = 0;
+        dram_access_latency = 0;
+        flash_access_latency = 0;
+        cache_overhead = 0;
+        flash_queue_cycles = 0;
+        prefetches_issued = 0;
+        prefetches_throttled = 0;
+        prefetch_hits = 0;
+        prefetch_late_hits = 0;
+        prefetch_late_cycles = 0;
+        prefetch_unused_evictions = 0;
+
+        migration_cycles = 0;
+        migrations_to_dram = 0;
+        migrations_to_flash = 0;
+        migration_mid_copy_accesses = 0;
+
+        if (flash_timing != nullptr) flash_timing->resetStats();
+        if (compressed_dram != nullptr) compressed_dram->resetStats();
+        if (flat_tiers != nullptr) flat_tiers->resetStats();
+        if (tiers != nullptr) tiers->resetStats();
+        if (caches != nullptr) caches->resetStats();
+
+        // Completed phases, snapshots and detector signatures are kept. The open trace
+        // phase and detector interval are re-based onto the zeroed counters so they keep
+        // what they gathered before the reset (the unsigned differences wrap back).
+        StatsSnapshot now = snapshotStats();
+        trace_phase_start = snapshotDelta(now, phase_so_far);
+        interval_start = snapshotDelta(now, interval_so_far);
+        stats_start_cycle = current_cycle;
+        stats_resets++;
+    }
+
+    uint64_t MemorySimulator::accessAt(char operation, uint64_t address, uint64_t issue_cycle) {
+        // Overlapping requests from an external clock, which must arrive in issue order
+        // (MemorySystem queues them). Contention comes from the bank and flash busy-until
+        // timelines inside the model rather than from serialization.
+        if (issue_cycle > current_cycle) current_cycle = issue_cycle;
+
+        // Same path as a trace line: through the cache filter (unbatched, the caller needs
+        // the latency now) and the phase detector
+        if (caches == nullptr) {
+            uint64_t latency = serviceAccess(operation, address);
+            observePhase(address);
+            return latency;
+        }
+
+        CacheRequest request{address, operation};
+        memory_requests.clear();
+        caches->accessBatch(&request, 1, memory_requests);
+
+        // A request filtered on chip completes at once; otherwise it is done when the
+        // slowest memory request it caused (fill, write-through or writeback) is
+        uint64_t latency = 0;
+        for (const CacheRequest& memory_request : memory_requests) {
+            latency = max(latency, serviceAccess(memory_request.operation, memory_request.address));
+            observePhase(memory_request.address);
+        }
+        return latency;
+    }
+
+    uint64_t MemorySimulator::serviceAccess(char operation, uint64_t address) {
+        // Out-of-range addresses are counted and completed at once, without touching the model
+        if (!addressInRange(address)) {
+            rejected_accesses++;
+            return 0;
+        }
+
         total_accesses++;
+        uint64_t latency_before = total_latency;
+        service_latency_base = total_latency;
+
+        if (tiers != nullptr) {
+            // N-tier hierarchy: placement and migration handled per tier
+            total_latency += tiers->access(operation, address, current_cycle);
+        } else if (hybrid_mode && flash != nullptr) {
+            // Hybrid memory logic: DRAM-as-cache or flat tiering
+            if (flat_tiers != nullptr) {
+                processFlatAccess(operation, address);
+            } else {
+                processHybridAccess(operation, address);
+            }
+        } else {
+            // ========== DRAM-only mode: No caching, pure DRAM ==========
+            total_latency += accessDRAM(operation, address);
+        }
 
-        // Hybrid memory logic: DRAM-as-cache model
-        if (hybrid_mode && flash != nullptr) {
-            // Update access frequency
-            updateAccessFrequency(address);
-
-            // Check if address is cached in DRAM
-            bool cached_in_dram = (data_in_dram_cache.find(address) != data_in_dram_cache.end())
-                                  && data_in_dram_cache[address];
-            bool is_hot = isHotData(address);
-
-            // Cache management logic
-            if (is_hot && !cached_in_dram) {
-                // HOT data not in cache → PROMOTE to DRAM cache
-                cache_promotions++;
-                cache_overhead += CACHE_PROMOTION_LATENCY;
-                total_latency += CACHE_PROMOTION_LATENCY;
-                data_in_dram_cache[address] = true;
-                cached_in_dram = true;
-            } else if (!is_hot && cached_in_dram) {
-                // COLD data in cache → EVICT from DRAM cache
-                cache_evictions++;
-                cache_overhead += CACHE_EVICTION_LATENCY;
-                total_latency += CACHE_EVICTION_LATENCY;
-                data_in_dram_cache[address] = false;
-                cached_in_dram = false;
-            }
-
-            // Access the data
-            if (cached_in_dram) {
-                // ========== CACHE HIT: Access from DRAM cache (FAST!) ==========
-                dram_cache_hits++;
-
-                uint32_t bank_index = (address >> 12) & 0x3;
-                uint32_t row_index = (address >> 2) & 0x3FF;
-                uint32_t col_index = address & 0x3;
-
-                if (bank_index >= banks.size() || row_index >= banks[bank_index].rows.size() ||
-                    col_index >= banks[bank_index].rows[row_index].size()) {
-                    cerr << "Warning: Address out of bounds: " << hex << address << endl;
-                    return;
-                }
+        service_latency_base = total_latency;
+        return total_latency - latency_before;
+    }
 
-                Bank& bank = banks[bank_index];
+    bool MemorySimulator::addressInRange(uint64_t address) const {
+        if (tiers != nullptr) return true;      // The last tier backs the whole address space
+        if (hybrid_mode && flash != nullptr && address / flash->page_size >= flash->pages.size()) {
+            return false;
+        }
 
-                // Row buffer hit/miss
-                uint32_t access_latency;
-                if (bank.active_row == row_index) {
-                    row_hits++;
-                    access_latency = ROW_HIT_LATENCY;  // 10 cycles - FAST!
-                } else {
-                    row_misses++;
-                    access_latency = ROW_MISS_LATENCY; // 30 cycles
-                    bank.active_row = row_index;
+        // Every other mode reaches accessDRAM, whose mapping must land inside the arrays
+        uint32_t bank_index = (address >> 12) & 0x3;
+        uint32_t row_index = (address >> 2) & 0x3FF;
+        uint32_t col_index = address & 0x3;
+        return bank_index < banks.size() && row_index < banks[bank_index].rows.size() &&
+               col_index < banks[bank_index].rows[row_index].size();
+    }
+
+    uint64_t MemorySimulator::accessClock() const {
+        // Time has already moved on by whatever the access in service has been charged so far
+        return current_cycle + (total_latency - service_latency_base);
+    }
+
+    void MemorySimulator::processHybridAccess(char operation, uint64_t address) {
+        // Update access frequency
+        updateAccessFrequency(address);
+
+        // Check if address is cached in DRAM
+        auto cached = data_in_dram_cache.find(address);
+        bool cached_in_dram = cached != data_in_dram_cache.end();
+        bool is_hot = isHotData(address);
+        uint64_t page_number = address / flash->page_size;
+        if (cached_in_dram) dram_cache_lru.splice(dram_cache_lru.begin(), dram_cache_lru, cached->second);
+        if (compressed_dram != nullptr) compressed_dram->observe(page_number);
+
+        // Cache management logic
+        bool promote = is_hot && !cached_in_dram;
+        uint32_t compress_latency = 0;
+        if (promote && compressed_dram != nullptr) {
+            // A page whose compressed size exceeds the whole tier stays in flash only
+            promote = compressed_dram->insert(page_number, compress_latency, compression_victims);
+        }
+        if (promote) {
+            // HOT data not in cache → PROMOTE to DRAM cache
+            cache_promotions++;
+            cache_overhead += CACHE_PROMOTION_LATENCY + compress_latency;
+            total_latency += CACHE_PROMOTION_LATENCY + compress_latency;
+
+            // Pages dropped from the compressed tier take every cached address in them along
+            if (compressed_dram != nullptr) {
+                for (uint64_t victim : compression_victims) dropCachedPage(victim);
+            }
+            dram_cache_lru.push_front(address);
+            data_in_dram_cache[address] = dram_cache_lru.begin();
+            cached_in_dram = true;
+
+            // A bounded cache makes room by dropping its least recently used address
+            if (dram_cache_capacity > 0 && data_in_dram_cache.size() > dram_cache_capacity) {
+                evictCachedAddress(dram_cache_lru.back());
+                dram_cache_capacity_evictions++;
+            }
+        } else if (!is_hot && cached_in_dram) {
+            // COLD data in cache → EVICT from DRAM cache
+            evictCachedAddress(address);
+            cached_in_dram = false;
+        }
+
+        // A page staged by the prefetcher is served from the DRAM tier
+        bool served_by_prefetch = false;
+        bool first_prefetch_use = false;
+        if (!cached_in_dram && prefetcher != nullptr) {
+            auto staged = prefetch_buffer.find(page_number);
+            if (staged != prefetch_buffer.end()) {
+                served_by_prefetch = true;
+                if (!staged->second.used) {
+                    staged->second.used = true;
+                    first_prefetch_use = true;
+                    prefetch_hits++;
+                }
+                if (staged->second.ready_cycle > accessClock()) {
+                    // Late prefetch: wait for the in-flight promotion to land
+                    uint64_t wait = staged->second.ready_cycle - accessClock();
+                    if (first_prefetch_use) prefetch_late_hits++;
+                    prefetch_late_cycles += wait;
+                    total_latency += wait;
                 }
+            }
+        }
+
+        // Access the data
+        if (cached_in_dram || served_by_prefetch) {
+            // ========== CACHE HIT: Access from DRAM cache (FAST!) ==========
+            dram_cache_hits++;
+
+            uint32_t access_latency = accessDRAM(operation, address);
+            if (cached_in_dram && compressed_dram != nullptr) {
+                access_latency += compressed_dram->hit(page_number, operation == 'W');
+            }
+            total_latency += access_latency;
+            dram_access_latency += access_latency;
+
+            if (operation == 'W') {
+                // Write-through: also update Flash
+                uint32_t write_latency = flashWriteLatency(page_number);
+                flash_writes++;
+                flash_access_latency += write_latency;
+                total_latency += write_latency;
+            }
+
+        } else {
+            // ========== CACHE MISS: Access from Flash only (SLOW) ==========
+            dram_cache_misses++;
 
-                total_latency += access_latency;
-                dram_access_latency += access_latency;
+            uint32_t page_index = address / flash->page_size;
+            uint32_t byte_offset = address % flash->page_size;
+            FlashPage& page = flash->pages[page_index];
+            uint32_t access_latency = 0;
 
-                // Perform DRAM operation
-                if (operation == 'R') {
-                    volatile uint8_t data = bank.rows[row_index][col_index];
+            if (operation == 'R') {
+                flash_reads++;
+                access_latency = flashReadLatency(page_number);   // ~100 cycles - slower than DRAM
+                if (byte_offset < page.data.size()) {
+                    volatile uint8_t data = page.data[byte_offset];
                     (void)data;
-                } else if (operation == 'W') {
-                    bank.rows[row_index][col_index] = 0xFF;
-                    // Write-through: also update Flash
-                    flash_writes++;
-                    flash_access_latency += FLASH_WRITE_LATENCY;
-                    total_latency += FLASH_WRITE_LATENCY;
                 }
+            } else if (operation == 'W') {
+                flash_writes++;
+                access_latency = flashWriteLatency(page_number);  // ~500 cycles - much slower
+                if (byte_offset < page.data.size()) {
+                    page.data[byte_offset] = 0xFF;
+                    page.write_count++;
+                }
+            }
 
-            } else {
-                // ========== CACHE MISS: Access from Flash only (SLOW) ==========
-                dram_cache_misses++;
+            page.last_access_time = total_accesses;
+            total_latency += access_latency;
+            flash_access_latency += access_latency;
+        }
 
-                uint32_t page_index = address / flash->page_size;
-                uint32_t byte_offset = address % flash->page_size;
+        if (prefetcher != nullptr) {
+            bool flash_miss = (!cached_in_dram && !served_by_prefetch) || first_prefetch_use;
+            runPrefetcher(page_number, flash_miss);
+        }
+    }
 
-                if (page_index >= flash->pages.size()) {
-                    cerr << "Warning: Flash address out of bounds: " << hex << address << endl;
-                    return;
-                }
+    void MemorySimulator::evictCachedAddress(uint64_t address) {
+        auto cached = data_in_dram_cache.find(address);
+        if (cached == data_in_dram_cache.end()) return;
 
-                FlashPage& page = flash->pages[page_index];
-                uint32_t access_latency;
-
-                if (operation == 'R') {
-                    flash_reads++;
-                    access_latency = FLASH_READ_LATENCY;  // 100 cycles - slower than DRAM
-                    if (byte_offset < page.data.size()) {
-                        volatile uint8_t data = page.data[byte_offset];
-                        (void)data;
-                    }
-                } else if (operation == 'W') {
-                    flash_writes++;
-                    access_latency = FLASH_WRITE_LATENCY;  // 500 cycles - much slower
-                    if (byte_offset < page.data.size()) {
-                        page.data[byte_offset] = 0xFF;
-                        page.write_count++;
-                    }
-                }
+        cache_evictions++;
+        cache_overhead += CACHE_EVICTION_LATENCY;
+        total_latency += CACHE_EVICTION_LATENCY;
+        dram_cache_lru.erase(cached->second);
+        data_in_dram_cache.erase(cached);
+
+        // The compressed tier holds whole pages: keep it while another address in it is cached
+        uint64_t page_number = address / flash->page_size;
+        if (compressed_dram != nullptr && cachedAddressesIn(page_number) == 0) {
+            compressed_dram->evict(page_number);
+        }
+    }
+
+    uint64_t MemorySimulator::cachedAddressesIn(uint64_t page_number) const {
+        uint64_t end = (page_number + 1) * flash->page_size;
+        uint64_t count = 0;
+        for (auto cached = data_in_dram_cache.lower_bound(page_number * flash->page_size);
+             cached != data_in_dram_cache.end() && cached->first < end; ++cached) {
+            count++;
+        }
+        return count;
+    }
+
+    void MemorySimulator::dropCachedPage(uint64_t page_number) {
+        uint64_t end = (page_number + 1) * flash->page_size;
+        auto cached = data_in_dram_cache.lower_bound(page_number * flash->page_size);
+        while (cached != data_in_dram_cache.end() && cached->first < end) {
+            dram_cache_lru.erase(cached->second);
+            cached = data_in_dram_cache.erase(cached);
+        }
+    }
+
+    void MemorySimulator::processFlatAccess(char operation, uint64_t address) {
+        // Placement decisions happen at epoch boundaries in simulated time
+        while (current_cycle >= next_migration_epoch) {
+            runMigrationEpoch();
+            next_migration_epoch += max<uint64_t>(1, sim_config.migration_epoch);
+        }
+        issueMigrations(accessClock());
+
+        // The epoch already moved the page logically, but its data stays in the old tier
+        // until the copy completes
+        uint64_t page_number = address / flash->page_size;
+        bool in_dram = flat_tiers->access(page_number);
+        auto migrating = migrating_pages.find(page_number);
+        if (migrating != migrating_pages.end()) {
+            in_dram = migrating->second.data_in_dram;
+            migration_mid_copy_accesses++;
+        }
+
+        if (in_dram) {
+            // ========== Page resident in DRAM: no flash copy to keep in sync ==========
+            dram_cache_hits++;
+            uint32_t access_latency = accessDRAM(operation, address);
+            total_latency += access_latency;
+            dram_access_latency += access_latency;
+            return;
+        }
 
-                page.last_access_time = total_accesses;
-                total_latency += access_latency;
-                flash_access_latency += access_latency;
+        // ========== Page resident in flash ==========
+        dram_cache_misses++;
+
+        // Demand shares flash with background migrations: the copy in flight holds the
+        // device (or its die with the geometry model) and demand queues behind it there
+        FlashPage& page = flash->pages[page_number];
+        uint32_t byte_offset = address % flash->page_size;
+        uint32_t access_latency = 0;
+        if (operation == 'R') {
+            flash_reads++;
+            access_latency = flashReadLatency(page_number);
+            if (byte_offset < page.data.size()) {
+                volatile uint8_t data = page.data[byte_offset];
+                (void)data;
+            }
+        } else if (operation == 'W') {
+            flash_writes++;
+            access_latency = flashWriteLatency(page_number);
+            if (byte_offset < page.data.size()) {
+                page.data[byte_offset] = 0xFF;
+                page.write_count++;
             }
+        }
+
+        page.last_access_time = total_accesses;
+        total_latency += access_latency;
+        flash_access_latency += access_latency;
+    }
 
+    void MemorySimulator::runMigrationEpoch() {
+        flat_tiers->endEpoch(migrate_up, migrate_down);
+
+        // Victims leave first so their frames are free for the promoted pages. Copies are
+        // queued and issued one at a time, so demand never waits behind a whole epoch's worth.
+        for (uint64_t page_number : migrate_down) queueMigration(page_number, false);
+        for (uint64_t page_number : migrate_up) queueMigration(page_number, true);
+        migration_busy_until = max(migration_busy_until, current_cycle);
+    }
+
+    void MemorySimulator::queueMigration(uint64_t page_number, bool to_dram) {
+        pending_migrations.push_back(MigrationCopy{page_number, to_dram});
+        auto migrating = migrating_pages.find(page_number);
+        if (migrating == migrating_pages.end()) {
+            migrating_pages[page_number] = MigratingPage{1, !to_dram};
         } else {
-            // ========== DRAM-only mode: No caching, pure DRAM ==========
-            uint32_t bank_index = (address >> 12) & 0x3;
-            uint32_t row_index = (address >> 2) & 0x3FF;
-            uint32_t col_index = address & 0x3;
+            migrating->second.copies++;
+        }
+    }
 
-            if (bank_index >= banks.size() || row_index >= banks[bank_index].rows.size() ||
-                col_index >= banks[bank_index].rows[row_index].size()) {
-                cerr << "Warning: Address out of bounds: " << hex << address << endl;
-                return;
+    void MemorySimulator::issueMigrations(uint64_t now) {
+        // Each copy starts when the previous one finishes; only copies due by now are issued
+        while (migration_busy_until <= now) {
+            if (migration_copying) {
+                // The copy in flight has landed: its page's data now lives in the new tier
+                auto migrating = migrating_pages.find(migration_in_flight.page_number);
+                migrating->second.data_in_dram = migration_in_flight.to_dram;
+                if (--migrating->second.copies == 0) migrating_pages.erase(migrating);
+                migration_copying = false;
             }
+            if (pending_migrations.empty()) break;
 
-            Bank& bank = banks[bank_index];
-
-            // Row buffer hit/miss logic
-            if (bank.active_row == row_index) {
-                row_hits++;
-                total_latency += ROW_HIT_LATENCY;
+            migration_in_flight = pending_migrations.front();
+            pending_migrations.pop_front();
+            migration_copying = true;
+            if (migration_in_flight.to_dram) {
+                migrateToDRAM(migration_in_flight.page_number, migration_busy_until);
             } else {
-                row_misses++;
-                total_latency += ROW_MISS_LATENCY;
-                bank.active_row = row_index;
+                migrateToFlash(migration_in_flight.page_number, migration_busy_until);
             }
+        }
+    }
 
-            // Perform operation
-            if (operation == 'R') {
-                volatile uint8_t data = bank.rows[row_index][col_index];
-                (void)data;
-            } else if (operation == 'W') {
-                bank.rows[row_index][col_index] = 0xFF;
+    void MemorySimulator::resetMigrationState() {
+        if (flat_tiers != nullptr) flat_tiers->reset();
+        migrate_up.clear();
+        migrate_down.clear();
+        pending_migrations.clear();
+        migrating_pages.clear();
+        migration_copying = false;
+        migration_mid_copy_accesses = 0;
+        next_migration_epoch = sim_config.migration_epoch == 0 ? UINT64_MAX : sim_config.migration_epoch;
+        migration_busy_until = 0;
+        migration_cycles = 0;
+        migrations_to_dram = 0;
+        migrations_to_flash = 0;
+    }
+
+    void MemorySimulator::runPrefetcher(uint64_t page_number, bool flash_miss) {
+        uint64_t now = accessClock();
+        prefetch_candidates.clear();
+        prefetcher->observe(page_number, flash_miss, prefetch_candidates);
+
+        for (uint64_t candidate : prefetch_candidates) {
+            if (candidate >= flash->pages.size() || prefetch_buffer.count(candidate) != 0) {
+                continue;
+            }
+
+            // Bandwidth budget: at most prefetch_budget promotions per prefetch_window cycles
+            if (now >= prefetch_window_start + sim_config.prefetch_window) {
+                prefetch_window_start = now;
+                prefetch_window_issued = 0;
+            }
+            if (prefetch_window_issued >= sim_config.prefetch_budget) {
+                prefetches_throttled++;
+                continue;
+            }
+            prefetch_window_issued++;
+            prefetches_issued++;
+
+            // Prefetch reads occupy the same flash timeline as demand reads
+            uint64_t data_ready;
+            flash_reads++;
+            if (flash_timing != nullptr) {
+                // Prefetches run on whichever die holds the page, in parallel with others
+                data_ready = flash_timing->read(candidate, now);
             } else {
-                cerr << "Warning: Unknown operation '" << operation << "'" << endl;
+                data_ready = max(now, flash_busy_until) + FLASH_READ_LATENCY;
+                flash_busy_until = data_ready;
+            }
+            prefetch_buffer[candidate] = PrefetchEntry{data_ready + CACHE_PROMOTION_LATENCY, false};
+            prefetch_order.push_back(candidate);
+
+            // FIFO replacement within the prefetch area of the DRAM tier
+            if (prefetch_order.size() > sim_config.prefetch_buffer_pages) {
+                auto victim = prefetch_buffer.find(prefetch_order.front());
+                if (!victim->second.used) prefetch_unused_evictions++;
+                prefetch_buffer.erase(victim);
+                prefetch_order.pop_front();
             }
         }
     }
 
+    uint32_t MemorySimulator::flashReadLatency(uint64_t page_number) {
+        uint64_t now = accessClock();
+        if (flash_timing == nullptr) return fixedFlashAccess(now, FLASH_READ_LATENCY) - now;
+        return flash_timing->read(page_number, now) - now;
+    }
+
+    uint32_t MemorySimulator::flashWriteLatency(uint64_t page_number) {
+        // With the geometry model a write is acknowledged once it is latched on the die
+        uint64_t now = accessClock();
+        if (flash_timing == nullptr) return fixedFlashAccess(now, FLASH_WRITE_LATENCY) - now;
+        return flash_timing->program(page_number, now) - now;
+    }
+
+    uint64_t MemorySimulator::fixedFlashAccess(uint64_t now, uint32_t latency) {
+        // Fixed-latency flash is a single device: a demand access queues behind
+        // prefetch reads and any other flash work already booked on it
+        uint64_t start = max(now, flash_busy_until);
+        flash_queue_cycles += start - now;
+        flash_busy_until = start + latency;
+        return flash_busy_until;
+    }
+
+    void MemorySimulator::resetPrefetchState() {
+        if (prefetcher != nullptr) prefetcher->reset();
+        prefetch_buffer.clear();
+        prefetch_order.clear();
+        prefetch_window_start = 0;
+        prefetch_window_issued = 0;
+
+        prefetches_issued = 0;
+        prefetches_throttled = 0;
+        prefetch_hits = 0;
+        prefetch_late_hits = 0;
+        prefetch_late_cycles = 0;
+        prefetch_unused_evictions = 0;
+    }
+
+    uint32_t MemorySimulator::accessDRAM(char operation, uint64_t address) {
+        uint32_t bank_index = (address >> 12) & 0x3;
+        uint32_t row_index = (address >> 2) & 0x3FF;
+        uint32_t col_index = address & 0x3;
+        Bank& bank = banks[bank_index];
+
+        // Overlapping requests wait for the bank to finish the previous access
+        uint64_t now = accessClock();
+        uint64_t start = max(now, bank.last_access_cycle);
+        bank_busy_cycles += start - now;
+
+        // Wait out any refresh that must be issued before this access
+        uint32_t refresh_stall = refreshStall(bank_index, start);
+
+        // Timeout policy: an idle bank has been precharged in the background
+        if (sim_config.page_policy == PagePolicy::TIMEOUT && bank.active_row != Bank::NO_OPEN_ROW &&
+            start >= bank.last_access_cycle + sim_config.page_timeout) {
+            bank.active_row = Bank::NO_OPEN_ROW;
+            policy_precharges++;
+        }
+
+        // Row buffer hit / row-empty miss / row-conflict miss. A refresh forgets the previous
+        // row, so a row it closed is neither a premature precharge nor policy training.
+        bool row_known = (bank.last_row != Bank::NO_OPEN_ROW);
+        bool row_reused = (bank.last_row == row_index);
+        uint32_t access_latency;
+        if (bank.active_row == row_index) {
+            row_hits++;
+            access_latency = ROW_HIT_LATENCY;   // 10 cycles - FAST!
+        } else if (bank.active_row == Bank::NO_OPEN_ROW) {
+            row_misses++;
+            row_empty_misses++;
+            access_latency = ROW_EMPTY_LATENCY; // 20 cycles - no precharge needed
+            if (row_reused) {
+                // An open-page policy would have hit here
+                premature_precharges++;
+            }
+        } else {
+            row_misses++;
+            row_conflict_misses++;
+            access_latency = ROW_MISS_LATENCY;  // 30 cycles - precharge on the critical path
+        }
+        access_latency += refresh_stall + (start - now);
+        bank.active_row = row_index;
+        bank.last_row = row_index;
+        bank.last_access_cycle = now + access_latency;
+
+        RefreshState& refresh_unit = (sim_config.refresh_mode == RefreshMode::ALL_BANK) ? rank_refresh : bank.refresh;
+        refresh_unit.idle_since = max(refresh_unit.idle_since, bank.last_access_cycle);
+
+        // Perform operation
+        if (operation == 'R') {
+            volatile uint8_t data = bank.rows[row_index][col_index];
+            (void)data;
+        } else if (operation == 'W') {
+            bank.rows[row_index][col_index] = 0xFF;
+        } else {
+            cerr << "Warning: Unknown operation '" << operation << "'" << endl;
+        }
+
+        applyPagePolicy(bank, row_known, row_reused);
+        return access_latency;
+    }
+
+    void MemorySimulator::applyPagePolicy(Bank& bank, bool row_known, bool row_reused) {
+        bool close_row = false;
+
+        switch (sim_config.page_policy) {
+            case PagePolicy::OPEN:
+            case PagePolicy::TIMEOUT:
+                // Closed lazily (on conflict, or on the next access after the timeout)
+                break;
+            case PagePolicy::CLOSED:
+                close_row = true;
+                break;
+            case PagePolicy::ADAPTIVE:
+                // Train on whether this access reused the previous row, then predict the next one
+                if (row_known && row_reused && bank.reuse_counter < 3) {
+                    bank.reuse_counter++;
+                } else if (row_known && !row_reused && bank.reuse_counter > 0) {
+                    bank.reuse_counter--;
+                }
+                close_row = (bank.reuse_counter < 2);
+                break;
+        }
+
+        if (close_row) {
+            bank.active_row = Bank::NO_OPEN_ROW;
+            policy_precharges++;
+        }
+    }
+
+    StatsSnapshot MemorySimulator::snapshotStats() const {
+        StatsSnapshot snapshot;
+        snapshot.total_accesses = total_accesses;
+        snapshot.rejected_accesses = rejected_accesses;
+        snapshot.total_latency = total_latency;
+        snapshot.current_cycle = current_cycle;
+        snapshot.row_hits = row_hits;
+        snapshot.row_misses = row_misses;
+        snapshot.row_empty_misses = row_empty_misses;
+        snapshot.row_conflict_misses = row_conflict_misses;
+        snapshot.refresh_cycles = refresh_cycles;
+        snapshot.refresh_commands = refresh_commands;
+        snapshot.dram_cache_hits = dram_cache_hits;
+        snapshot.dram_cache_misses = dram_cache_misses;
+        snapshot.flash_reads = flash_reads;
+        snapshot.flash_writes = flash_writes;
+        snapshot.cache_promotions = cache_promotions;
+        snapshot.cache_evictions = cache_evictions;
+        snapshot.prefetches_issued = prefetches_issued;
+        snapshot.prefetch_hits = prefetch_hits;
+        return snapshot;
+    }
+
     void MemorySimulator::performRefresh() {
-        refresh_cycles += 1;
-        total_latency += 100; // Placeholder latency for refresh
+        // Issue every refresh that has fallen due by now and fits in idle time; the tier
+        // hierarchy replaces the DRAM model, so there is nothing to refresh then
+        if (tiers != nullptr) return;
+        if (sim_config.refresh_mode == RefreshMode::ALL_BANK) {
+            noteRefreshes(banks.size(), issueIdleRefreshes(rank_refresh, current_cycle));
+            max_refresh_backlog = max(max_refresh_backlog, rank_refresh.pending);
+        } else {
+            for (uint32_t i = 0; i < banks.size(); i++) {
+                noteRefreshes(i, issueIdleRefreshes(banks[i].refresh, current_cycle));
+                max_refresh_backlog = max(max_refresh_backlog, banks[i].refresh.pending);
+            }
+        }
+    }
+
+    uint32_t MemorySimulator::issueIdleRefreshes(RefreshState& unit, uint64_t now) {
+        while (unit.next_due <= now) {
+            unit.pending++;
+            unit.next_due += refresh_period;
+        }
+
+        // Owed refreshes go out oldest first in the gap since the last access
+        uint64_t cursor = max(unit.idle_since, unit.busy_until);
+        uint32_t issued = 0;
+        while (unit.pending > 0) {
+            uint64_t due = unit.next_due - (uint64_t)unit.pending * refresh_period;
+            uint64_t start = max(cursor, due);
+            if (start + refresh_duration > now) break;
+            cursor = start + refresh_duration;
+            unit.busy_until = cursor;
+            unit.pending--;
+            issued++;
+        }
+        refreshes_hidden += issued;
+        return issued;
+    }
+
+    uint32_t MemorySimulator::refreshStall(uint32_t bank_index, uint64_t now) {
+        bool all_bank = (sim_config.refresh_mode == RefreshMode::ALL_BANK);
+        RefreshState& unit = all_bank ? rank_refresh : banks[bank_index].refresh;
+
+        uint32_t issued = issueIdleRefreshes(unit, now);
+
+        // Beyond the postponement limit the owed refreshes go ahead of this access
+        uint64_t ready = max(now, unit.busy_until);
+        while (unit.pending > sim_config.refresh_max_postpone) {
+            ready += refresh_duration;
+            unit.pending--;
+            refreshes_forced++;
+            issued++;
+        }
+        max_refresh_backlog = max(max_refresh_backlog, unit.pending);
+        unit.busy_until = max(unit.busy_until, ready);
+
+        noteRefreshes(all_bank ? banks.size() : bank_index, issued);
+
+        uint32_t stall = ready - now;
+        refresh_stall_cycles += stall;
+        banks[bank_index].refresh_stall_cycles += stall;
+        return stall;
+    }
+
+    void MemorySimulator::noteRefreshes(uint32_t bank_index, uint32_t count) {
+        // bank_index == banks.size() means an all-bank command
+        if (count == 0) return;
+        refresh_commands += count;
+        refresh_cycles += (uint64_t)count * refresh_duration;
+
+        // Refresh requires precharged banks, so it closes any open row
+        uint32_t first = bank_index < banks.size() ? bank_index : 0;
+        uint32_t last = bank_index < banks.size() ? bank_index + 1 : banks.size();
+        for (uint32_t i = first; i < last; i++) {
+            banks[i].refreshes += count;
+            banks[i].active_row = Bank::NO_OPEN_ROW;
+            banks[i].last_row = Bank::NO_OPEN_ROW;
+        }
+    }
+
+    void MemorySimulator::resetRefreshState() {
+        rank_refresh.reset(refresh_period);
+        for (uint32_t i = 0; i < banks.size(); i++) {
+            // Per-bank commands are staggered evenly across the refresh period
+            banks[i].refresh.reset(refresh_period * (i + 1) / banks.size());
+            banks[i].refreshes = 0;
+            banks[i].refresh_stall_cycles = 0;
+        }
+        refreshes_hidden = 0;
+        refreshes_forced = 0;
+        refresh_stall_cycles = 0;
+        max_refresh_backlog = 0;
     }
 
     void MemorySimulator::printStats() {
-        cout << "\n=== DRAM Memory Statistics ===" << endl;
+        cout << "\n=== " << (tiers != nullptr ? "Access" : "DRAM Memory") << " Statistics ===" << endl;
         cout << "-----------------------------------" << endl;
 
         // Basic access statistics
         cout << "Total Memory Accesses:     " << total_accesses << endl;
-        cout << "Row Buffer Hits:           " << row_hits << endl;
-        cout << "Row Buffer Misses:         " << row_misses << endl;
-        cout << "Refresh Cycles:            " << refresh_cycles << endl;
+        if (rejected_accesses > 0) {
+            cout << "Rejected Accesses:         " << rejected_accesses << " (address out of range)" << endl;
+        }
+        // The tier hierarchy replaces the DRAM model: no rows, banks or refresh to report
+        if (tiers == nullptr) {
+            cout << "Row Buffer Hits:           " << row_hits << endl;
+            cout << "Row Buffer Misses:         " << row_misses
+                 << " (empty: " << row_empty_misses << ", conflict: " << row_conflict_misses << ")" << endl;
+            cout << "Refresh Cycles:            " << refresh_cycles << endl;
+
+            cout << "\n--- Refresh ---" << endl;
+            cout << "Refresh Mode:              "
+                 << (sim_config.refresh_mode == RefreshMode::ALL_BANK ? "all-bank" : "per-bank")
+                 << ", " << sim_config.refresh_granularity << "x granularity" << endl;
+            cout << "Refresh Timing:            every " << refresh_period << " cycles, tRFC "
+                 << refresh_duration << " cycles, up to " << sim_config.refresh_max_postpone << " postponed" << endl;
+            cout << "Refresh Commands:          " << refresh_commands << " (hidden in idle time: "
+                 << refreshes_hidden << ", forced: " << refreshes_forced << ")" << endl;
+            cout << "Max Refresh Backlog:       " << max_refresh_backlog << endl;
+            cout << "Refresh Stall Cycles:      " << refresh_stall_cycles << endl;
+            for (size_t i = 0; i < banks.size(); i++) {
+                if (banks[i].refreshes == 0 && banks[i].refresh_stall_cycles == 0) continue;
+                cout << "  Bank " << i << ":                   " << banks[i].refreshes << " refreshes, "
+                     << banks[i].refresh_stall_cycles << " stall cycles" << endl;
+            }
+
+            cout << "\n--- Row-Buffer Policy ---" << endl;
+            cout << "Page Policy:               " << pagePolicyName(sim_config.page_policy);
+            if (sim_config.page_policy == PagePolicy::TIMEOUT) {
+                cout << " (" << sim_config.page_timeout << " cycles)";
+            }
+            cout << endl;
+            cout << "Policy Precharges:         " << policy_precharges << endl;
+            cout << "Premature Precharges:      " << premature_precharges
+                 << " (closed rows that were reused)" << endl;
+            if (sim_config.max_outstanding > 1 || bank_busy_cycles > 0) {
+                cout << "Bank Busy Wait:            " << bank_busy_cycles
+                     << " cycles (overlapping requests to one bank)" << endl;
+            }
+        }
 
         cout << "\n--- Performance Metrics ---" << endl;
 
-        // Hit ratio
-        if (total_accesses > 0) {
-            double hit_ratio = (double)row_hits / total_accesses * 100.0;
-            double miss_ratio = (double)row_misses / total_accesses * 100.0;
-            cout << "Row Buffer Hit Ratio:      " << fixed << setprecision(2)
-                << hit_ratio << "%" << endl;
-            cout << "Row Buffer Miss Ratio:     " << fixed << setprecision(2)
-                << miss_ratio << "%" << endl;
-        } else {
-            cout << "Row Buffer Hit Ratio:      N/A (no accesses)" << endl;
-            cout << "Row Buffer Miss Ratio:     N/A (no accesses)" << endl;
+        // Row-buffer hit ratio (the tier hierarchy reports per tier instead)
+        if (tiers == nullptr) {
+            if (total_accesses > 0) {
+                double hit_ratio = (double)row_hits / total_accesses * 100.0;
+                double miss_ratio = (double)row_misses / total_accesses * 100.0;
+                double empty_ratio = (double)row_empty_misses / total_accesses * 100.0;
+                double conflict_ratio = (double)row_conflict_misses / total_accesses * 100.0;
+                cout << "Row Buffer Hit Ratio:      " << fixed << setprecision(2)
+                    << hit_ratio << "%" << endl;
+                cout << "Row Buffer Miss Ratio:     " << fixed << setprecision(2)
+                    << miss_ratio << "%" << endl;
+                cout << "  Row-Empty Miss Ratio:    " << fixed << setprecision(2)
+                    << empty_ratio << "%" << endl;
+                cout << "  Row-Conflict Miss Ratio: " << fixed << setprecision(2)
+                    << conflict_ratio << "%" << endl;
+            } else {
+                cout << "Row Buffer Hit Ratio:      N/A (no accesses)" << endl;
+                cout << "Row Buffer Miss Ratio:     N/A (no accesses)" << endl;
+            }
         }
 
         // Average latency
@@ -432,49 +1503,80 @@ using namespace std;
             cout << "Throughput:                N/A" << endl;
         }
 
-        cout << "\n--- Bank Status ---" << endl;
-        cout << "Total Banks:               " << banks.size() << endl;
-        cout << "Rows per Bank:             " << (banks.empty() ? 0 : banks[0].rows.size()) << endl;
-        cout << "Columns per Row:           " << (banks.empty() || banks[0].rows.empty() ? 0 : banks[0].rows[0].size()) << endl;
+        if (tiers == nullptr) {
+            cout << "\n--- Bank Status ---" << endl;
+            cout << "Total Banks:               " << banks.size() << endl;
+            cout << "Rows per Bank:             " << (banks.empty() ? 0 : banks[0].rows.size()) << endl;
+            cout << "Columns per Row:           " << (banks.empty() || banks[0].rows.empty() ? 0 : banks[0].rows[0].size()) << endl;
+        }
 
-        // Hybrid memory statistics (DRAM-as-cache model)
+        // Hybrid memory statistics (DRAM-as-cache or flat model)
         if (hybrid_mode) {
-            cout << "\n=== Hybrid Memory Statistics (DRAM-as-Cache) ===" << endl;
+            // Flat mode has no cache: each page is resident in exactly one tier
+            bool flat = (flat_tiers != nullptr);
+            cout << "\n=== Hybrid Memory Statistics ("
+                 << (flat ? "Flat Tiering" : "DRAM-as-Cache") << ") ===" << endl;
             cout << "-----------------------------------" << endl;
 
-            cout << "\n--- Cache Performance ---" << endl;
-            cout << "DRAM Cache Hits:           " << dram_cache_hits << endl;
-            cout << "DRAM Cache Misses:         " << dram_cache_misses << endl;
-            if (total_accesses > 0) {
-                double cache_hit_rate = (double)dram_cache_hits / total_accesses * 100.0;
-                cout << "Cache Hit Rate:            " << fixed << setprecision(2)
-                     << cache_hit_rate << "% (hot data cached in DRAM)" << endl;
-            }
+            if (flat) {
+                cout << "\n--- Placement ---" << endl;
+                cout << "DRAM-Resident Hits:        " << dram_cache_hits << endl;
+                cout << "Flash-Resident Accesses:   " << dram_cache_misses << endl;
+                if (total_accesses > 0) {
+                    double dram_hit_rate = (double)dram_cache_hits / total_accesses * 100.0;
+                    cout << "DRAM Hit Rate:             " << fixed << setprecision(2)
+                         << dram_hit_rate << "% (page resident in DRAM)" << endl;
+                }
+            } else {
+                cout << "\n--- Cache Performance ---" << endl;
+                cout << "DRAM Cache Hits:           " << dram_cache_hits << endl;
+                cout << "DRAM Cache Misses:         " << dram_cache_misses << endl;
+                if (total_accesses > 0) {
+                    double cache_hit_rate = (double)dram_cache_hits / total_accesses * 100.0;
+                    cout << "Cache Hit Rate:            " << fixed << setprecision(2)
+                         << cache_hit_rate << "% (hot data cached in DRAM)" << endl;
+                }
 
-            cout << "\n--- Cache Management ---" << endl;
-            cout << "Cache Promotions:          " << cache_promotions
-                 << " (cold→hot, loaded into DRAM)" << endl;
-            cout << "Cache Evictions:           " << cache_evictions
-                 << " (hot→cold, evicted from DRAM)" << endl;
-            cout << "Cache Overhead:            " << cache_overhead << " cycles" << endl;
+                cout << "\n--- Cache Management ---" << endl;
+                cout << "Cache Promotions:          " << cache_promotions
+                     << " (cold→hot, loaded into DRAM)" << endl;
+                cout << "Cache Evictions:           " << cache_evictions
+                     << " (hot→cold, evicted from DRAM)" << endl;
+                cout << "Cache Overhead:            " << cache_overhead << " cycles" << endl;
+            }
 
             cout << "\n--- Access Breakdown ---" << endl;
             uint64_t dram_row_accesses = row_hits + row_misses;
-            cout << "DRAM Accesses (cached):    " << dram_row_accesses
-                 << " (row hits: " << row_hits << ", misses: " << row_misses << ")" << endl;
+            cout << (flat ? "DRAM Accesses:             " : "DRAM Accesses (cached):    ") << dram_row_accesses
+                 << " (row hits: " << row_hits << ", misses: " << row_misses
+                 << " [empty: " << row_empty_misses << ", conflict: " << row_conflict_misses << "])" << endl;
             if (dram_row_accesses > 0) {
                 double row_hit_rate = (double)row_hits / dram_row_accesses * 100.0;
                 cout << "  DRAM Row Buffer Hit Rate:" << fixed << setprecision(2)
                      << row_hit_rate << "%" << endl;
             }
-            cout << "Flash Reads (cache miss):  " << flash_reads << endl;
-            cout << "Flash Writes:              " << flash_writes
-                 << " (write-through + direct)" << endl;
+            if (flat) {
+                // Migration copies are reported under Flat Tiering
+                cout << "Flash Reads:               " << flash_reads << " (demand)" << endl;
+                cout << "Flash Writes:              " << flash_writes << " (demand, flash-resident pages)" << endl;
+            } else {
+                cout << "Flash Reads:               " << flash_reads
+                     << " (demand: " << flash_reads - prefetches_issued << ", prefetch: " << prefetches_issued << ")" << endl;
+                cout << "Flash Writes:              " << flash_writes
+                     << " (write-through + direct)" << endl;
+            }
 
             cout << "\n--- Latency Breakdown ---" << endl;
-            cout << "DRAM Cache Latency:        " << dram_access_latency << " cycles (FAST path)" << endl;
+            cout << (flat ? "DRAM Latency:              " : "DRAM Cache Latency:        ")
+                 << dram_access_latency << " cycles (FAST path)" << endl;
             cout << "Flash Access Latency:      " << flash_access_latency << " cycles (SLOW path)" << endl;
-            cout << "Cache Management:          " << cache_overhead << " cycles (promotion/eviction)" << endl;
+            if (!flat) {
+                cout << "Cache Management:          " << cache_overhead << " cycles (promotion/eviction)" << endl;
+            }
+            if (flash_timing == nullptr) {
+                cout << "Flash Queue Wait:          " << flash_queue_cycles
+                     << " cycles (demand behind other flash traffic)" << endl;
+            }
             cout << "Total Latency:             " << total_latency << " cycles" << endl;
 
             if (total_accesses > 0) {
@@ -486,30 +1588,148 @@ using namespace std;
             cout << "\n--- Performance Analysis ---" << endl;
             if (dram_cache_hits > 0) {
                 double avg_cache_hit_latency = (double)dram_access_latency / dram_cache_hits;
-                cout << "Avg Cache Hit Latency:     " << fixed << setprecision(2)
+                cout << (flat ? "Avg DRAM Latency:          " : "Avg Cache Hit Latency:     ") << fixed << setprecision(2)
                      << avg_cache_hit_latency << " cycles (when in DRAM)" << endl;
             }
             if (dram_cache_misses > 0) {
                 double avg_cache_miss_latency = (double)flash_access_latency / dram_cache_misses;
-                cout << "Avg Cache Miss Latency:    " << fixed << setprecision(2)
+                cout << (flat ? "Avg Flash Latency:         " : "Avg Cache Miss Latency:    ") << fixed << setprecision(2)
                      << avg_cache_miss_latency << " cycles (when in Flash only)" << endl;
             }
 
+            if (flat_tiers != nullptr) {
+                cout << "\n--- Flat Tiering ---" << endl;
+                flat_tiers->printStats();
+                cout << "Page Copies Issued:        " << migrations_to_dram << " to DRAM, "
+                     << migrations_to_flash << " to flash (" << pending_migrations.size() << " pending)" << endl;
+                cout << "Mid-Copy Accesses:         " << migration_mid_copy_accesses
+                     << " (served from the old tier until the copy landed)" << endl;
+                cout << "Migration Traffic:         " << (migrations_to_dram + migrations_to_flash) * flash->page_size
+                     << " bytes (" << migration_cycles << " copy cycles)" << endl;
+            }
+
+            if (compressed_dram != nullptr) {
+                cout << "\n--- Compressed DRAM Tier ---" << endl;
+                compressed_dram->printStats();
+            }
+
+            // Flat mode ranks pages in FlatTiering and never consults the hotness tracker
+            if (!flat) {
+                cout << "\n--- Hotness Tracking ---" << endl;
+                if (dram_cache_capacity > 0) {
+                    // Map node + LRU list node per cached address
+                    cout << "Cached Addresses:          " << data_in_dram_cache.size() << " / " << dram_cache_capacity
+                         << " (~" << dram_cache_capacity * 80 << " bytes max, LRU)" << endl;
+                    cout << "Capacity Evictions:        " << dram_cache_capacity_evictions << endl;
+                }
+                if (hotness != nullptr) {
+                    hotness->printStats();
+                } else {
+                    // Rough node cost of std::map<uint64_t, uint64_t>
+                    cout << "Tracker:                   exact per-address counts (no decay)" << endl;
+                    cout << "Tracked Addresses:         " << access_frequency.size()
+                         << " (~" << access_frequency.size() * 48 << " bytes)" << endl;
+                }
+            }
+
+            if (prefetcher != nullptr) {
+                cout << "\n--- Prefetch Engine ---" << endl;
+                cout << "Prefetcher:                " << prefetcher->name()
+                     << " (degree " << sim_config.prefetch_degree << ")" << endl;
+                cout << "Prefetches Issued:         " << prefetches_issued
+                     << " (throttled by budget: " << prefetches_throttled << ")" << endl;
+                cout << "Useful Prefetches:         " << prefetch_hits
+                     << " (late: " << prefetch_late_hits << ", " << prefetch_late_cycles << " cycles waited)" << endl;
+                cout << "Unused Evictions:          " << prefetch_unused_evictions << endl;
+                if (prefetches_issued > 0) {
+                    double accuracy = (double)prefetch_hits / prefetches_issued * 100.0;
+                    cout << "Prefetch Accuracy:         " << fixed << setprecision(2)
+                         << accuracy << "% (useful / issued)" << endl;
+                }
+                if (prefetch_hits + dram_cache_misses > 0) {
+                    double coverage = (double)prefetch_hits / (prefetch_hits + dram_cache_misses) * 100.0;
+                    cout << "Prefetch Coverage:         " << fixed << setprecision(2)
+                         << coverage << "% (flash misses eliminated)" << endl;
+                }
+                if (prefetch_hits > 0) {
+                    double timeliness = (double)(prefetch_hits - prefetch_late_hits) / prefetch_hits * 100.0;
+                    cout << "Prefetch Timeliness:       " << fixed << setprecision(2)
+                         << timeliness << "% (landed before demand)" << endl;
+                }
+            }
+
             cout << "\n--- Flash Memory Status ---" << endl;
             if (flash != nullptr) {
                 cout << "Total Flash Capacity:      " << flash->total_capacity << " bytes" << endl;
                 cout << "Flash Page Size:           " << flash->page_size << " bytes" << endl;
                 cout << "Total Flash Pages:         " << flash->pages.size() << endl;
             }
+            if (flash_timing != nullptr) {
+                flash_timing->printStats(current_cycle - stats_start_cycle);
+            }
 
             cout << "-----------------------------------" << endl;
         }
 
+        if (caches != nullptr) {
+            cout << "\n--- On-Chip Cache Filter ---" << endl;
+            caches->printStats();
+        }
+
+        if (stats_resets > 0 || !trace_phases.empty() || !trace_snapshots.empty() || !detected_phases.empty()) {
+            cout << "\n--- Phases ---" << endl;
+            if (stats_resets > 0) {
+                cout << "Statistics Reset:          " << stats_resets << " time(s), measuring from cycle "
+                     << stats_start_cycle << endl;
+            }
+            if (!trace_phases.empty()) {
+                cout << "Trace Phases:" << endl;
+                for (const PhaseRecord& phase : trace_phases) {
+                    printPhaseLine(phase.label, phase.stats, hybrid_mode);
+                }
+            }
+            if (!trace_snapshots.empty()) {
+                cout << "Snapshots (since reset):" << endl;
+                for (const PhaseRecord& snapshot : trace_snapshots) {
+                    printPhaseLine(snapshot.label, snapshot.stats, hybrid_mode);
+                }
+            }
+            if (!detected_phases.empty()) {
+                cout << "Detected Phases:           " << detected_phases.size() << " over "
+                     << phase_detector->timeline().size() << " intervals of " << sim_config.phase_interval
+                     << " accesses (" << phase_detector->transitions() << " transitions)" << endl;
+                for (const PhaseRecord& phase : detected_phases) {
+                    printPhaseLine(phase.label + " (" + to_string(phase.intervals) + " intervals)", phase.stats, hybrid_mode);
+                }
+
+                // Run-length encoded phase sequence, e.g. "0x4 1x12 0x3"
+                const vector<uint32_t>& timeline = phase_detector->timeline();
+                cout << "Phase Sequence:            ";
+                size_t runs = 0;
+                for (size_t i = 0; i < timeline.size() && runs < 32; runs++) {
+                    size_t j = i;
+                    while (j < timeline.size() && timeline[j] == timeline[i]) j++;
+                    cout << timeline[i] << "x" << (j - i) << " ";
+                    i = j;
+                }
+                if (runs == 32) cout << "...";
+                cout << endl;
+            }
+        }
+
+        if (tiers != nullptr) {
+            tiers->printStats(total_accesses);
+        }
+
         cout << "-----------------------------------" << endl;
     }
 
     // Helper methods for hybrid memory management
     bool MemorySimulator::isHotData(uint64_t address) {
+        if (hotness != nullptr) {
+            return hotness->estimate(address) >= HOT_DATA_THRESHOLD;
+        }
+
         // Check if address has been accessed frequently (hot data)
         if (access_frequency.find(address) != access_frequency.end()) {
             return access_frequency[address] >= HOT_DATA_THRESHOLD;
@@ -518,18 +1738,43 @@ using namespace std;
     }
 
     void MemorySimulator::updateAccessFrequency(uint64_t address) {
+        if (hotness != nullptr) {
+            hotness->increment(address);
+            return;
+        }
+
         // Increment access count for this address
         access_frequency[address]++;
     }
 
-    void MemorySimulator::migrateToDRAM(uint64_t address) {
-        // Legacy method - not used in cache model
-        (void)address;
+    void MemorySimulator::migrateToDRAM(uint64_t page_number, uint64_t start) {
+        // Flat mode: read the page out of flash on the timeline demand uses, then fill DRAM
+        uint64_t data_ready;
+        if (flash_timing != nullptr) {
+            data_ready = flash_timing->read(page_number, start);
+        } else {
+            data_ready = max(start, flash_busy_until) + FLASH_READ_LATENCY;
+            flash_busy_until = data_ready;
+        }
+        uint64_t done = data_ready + DRAM_FILL_LATENCY;
+        migration_cycles += done - start;
+        migration_busy_until = done;
+        migrations_to_dram++;
     }
 
-    void MemorySimulator::migrateToFlash(uint64_t address) {
-        // Legacy method - not used in cache model
-        (void)address;
+    void MemorySimulator::migrateToFlash(uint64_t page_number, uint64_t start) {
+        // Flat mode: write the demoted page back to flash; its DRAM frame is free once it is read out
+        uint64_t done;
+        if (flash_timing != nullptr) {
+            done = flash_timing->program(page_number, start);
+        } else {
+            done = max(start, flash_busy_until) + FLASH_WRITE_LATENCY;
+            flash_busy_until = done;
+        }
+        migration_cycles += done - start;
+        migration_busy_until = done;
+        if (page_number < flash->pages.size()) flash->pages[page_number].write_count++;
+        migrations_to_flash++;
     }
 
     void MemorySimulator::generateTrace(uint64_t num_accesses) {
@@ -563,7 +1808,9 @@ using namespace std;
         cout << "  Read/Write ratio: 70% reads, 30% writes" << endl;
         cout << "  Spatial locality: 30% (sequential row accesses)" << endl;
 
-        if (hybrid_mode) {
+        if (tiers != nullptr) {
+            cout << "\n  Tiered Mode: ENABLED (" << tiers->tierCount() << " tiers)" << endl;
+        } else if (hybrid_mode) {
             cout << "\n  Hybrid Mode: ENABLED" << endl;
             cout << "  Hot data threshold: " << HOT_DATA_THRESHOLD << " accesses" << endl;
             cout << "  Expected behavior: Hot addresses -> DRAM, Cold addresses -> Flash" << endl;
@@ -609,12 +1856,7 @@ using namespace std;
             char operation = (op_type(rng) < 70) ? 'R' : 'W';
 
             // Process the access
-            processAccess(operation, address);
-
-            // Periodic refresh (every 8192 accesses)
-            if (i % 8192 == 0 && i > 0) {
-                performRefresh();
-            }
+            submitAccess(operation, address);
 
             // Progress indicator for large traces
             if (num_accesses >= 10000 && i % (num_accesses / 10) == 0 && i > 0) {
@@ -622,6 +1864,11 @@ using namespace std;
             }
         }
 
+        drainAccesses();
+        waitForOutstanding();
+        performRefresh();
+        finishPhases();
+
         cout << "\nTrace generation complete!" << endl;
     }
 
@@ -0,0 +1,74 @@
+#include "./../include/phase_detector.h"
+#include <algorithm>
+
+using namespace std;
+
+static uint64_t mix64(uint64_t value) {
+    value = (value ^ (value >> 33)) * 0xFF51AFD7ED558CCDULL;
+    value = (value ^ (value >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+    return value ^ (value >> 33);
+}
+
+PhaseDetector::PhaseDetector(uint64_t interval, uint32_t region_bits, uint32_t signature_bits, double threshold)
+    : interval(max<uint64_t>(1, interval)), region_bits(min<uint32_t>(region_bits, 63)),
+      signature_bits(max<uint32_t>(64, signature_bits)), threshold(threshold) {
+    current.assign((this->signature_bits + 63) / 64, 0);
+    reset();
+}
+
+void PhaseDetector::reset() {
+    fill(current.begin(), current.end(), 0);
+    interval_accesses = 0;
+    signatures.clear();
+    history.clear();
+    phase_changes = 0;
+}
+
+int PhaseDetector::observe(uint64_t address) {
+    uint64_t bit = mix64(address >> region_bits) % signature_bits;
+    current[bit / 64] |= 1ULL << (bit % 64);
+
+    if (++interval_accesses < interval) return -1;
+    return classify();
+}
+
+int PhaseDetector::finish() {
+    if (interval_accesses == 0) return -1;
+    return classify();
+}
+
+double PhaseDetector::distance(const vector<uint64_t>& a, const vector<uint64_t>& b) {
+    uint64_t differing = 0, combined = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        differing += __builtin_popcountll(a[i] ^ b[i]);
+        combined += __builtin_popcountll(a[i] | b[i]);
+    }
+    return combined == 0 ? 0.0 : (double)differing / combined;
+}
+
+int PhaseDetector::classify() {
+    int best = -1;
+    double best_distance = threshold;
+    for (size_t phase = 0; phase < signatures.size(); phase++) {
+        double d = distance(current, signatures[phase]);
+        if (d <= best_distance) {
+            best = (int)phase;
+            best_distance = d;
+        }
+    }
+
+    if (best < 0) {
+        best = (int)signatures.size();
+        signatures.push_back(current);
+    } else {
+        // Track slow drift within a phase
+        signatures[best] = current;
+    }
+
+    if (!history.empty() && history.back() != (uint32_t)best) phase_changes++;
+    history.push_back(best);
+
+    fill(current.begin(), current.end(), 0);
+    interval_accesses = 0;
+    return best;
+}
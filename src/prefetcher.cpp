@@ -0,0 +1,142 @@
+#include "./../include/prefetcher.h"
+
+using namespace std;
+
+Prefetcher* Prefetcher::create(PrefetcherType type, uint32_t degree) {
+    switch (type) {
+        case PrefetcherType::NEXT_N: return new NextNPagePrefetcher(degree);
+        case PrefetcherType::STRIDE: return new StridePrefetcher(degree);
+        case PrefetcherType::STREAM: return new StreamPrefetcher(degree);
+        case PrefetcherType::NONE:   break;
+    }
+    return nullptr;
+}
+
+// ========== Next-N-page ==========
+
+NextNPagePrefetcher::NextNPagePrefetcher(uint32_t degree) : degree(degree) {}
+
+void NextNPagePrefetcher::observe(uint64_t page, bool flash_miss, vector<uint64_t>& candidates) {
+    if (!flash_miss) return;
+
+    for (uint32_t i = 1; i <= degree; i++) {
+        candidates.push_back(page + i);
+    }
+}
+
+// ========== Stride ==========
+
+StridePrefetcher::StridePrefetcher(uint32_t degree) : degree(degree) {
+    reset();
+}
+
+void StridePrefetcher::reset() {
+    table.assign(TABLE_SIZE, Entry{0, 0, 0, 0, false});
+}
+
+void StridePrefetcher::observe(uint64_t page, bool flash_miss, vector<uint64_t>& candidates) {
+    (void)flash_miss;
+
+    uint64_t region = page >> REGION_SHIFT;
+    Entry& entry = table[region % TABLE_SIZE];
+
+    if (!entry.valid || entry.region != region) {
+        entry = Entry{region, page, 0, 0, true};
+        return;
+    }
+
+    int64_t stride = (int64_t)page - (int64_t)entry.last_page;
+    if (stride == 0) return;
+
+    // Train: repeated strides build confidence, a new stride has to earn it again
+    if (stride == entry.stride) {
+        if (entry.confidence < 3) entry.confidence++;
+    } else {
+        if (entry.confidence > 0) entry.confidence--;
+        if (entry.confidence == 0) entry.stride = stride;
+    }
+    entry.last_page = page;
+
+    if (entry.confidence < CONFIRM_THRESHOLD) return;
+
+    for (uint32_t i = 1; i <= degree; i++) {
+        int64_t target = (int64_t)page + entry.stride * (int64_t)i;
+        if (target < 0) break;
+        candidates.push_back((uint64_t)target);
+    }
+}
+
+// ========== Stream ==========
+
+StreamPrefetcher::StreamPrefetcher(uint32_t degree) : degree(degree) {
+    reset();
+}
+
+void StreamPrefetcher::reset() {
+    access_clock = 0;
+    streams.assign(MAX_STREAMS, Stream{0, 0, 0, 0, 0, false});
+}
+
+void StreamPrefetcher::observe(uint64_t page, bool flash_miss, vector<uint64_t>& candidates) {
+    access_clock++;
+
+    // Look for a stream this access continues
+    Stream* match = nullptr;
+    for (auto& stream : streams) {
+        if (!stream.valid) continue;
+
+        int64_t delta = (int64_t)page - (int64_t)stream.last_page;
+        if (delta == 0) {
+            match = &stream;
+            break;
+        }
+
+        if (stream.direction == 0) {
+            // Second access of a new stream fixes its direction
+            if (delta > 0 && delta <= (int64_t)DETECT_WINDOW) stream.direction = 1;
+            else if (delta < 0 && -delta <= (int64_t)DETECT_WINDOW) stream.direction = -1;
+            else continue;
+            stream.next_prefetch = page + stream.direction;
+        } else {
+            int64_t progress = delta * stream.direction;
+            if (progress <= 0 || progress > (int64_t)DETECT_WINDOW) continue;
+        }
+
+        if (stream.confirmations < 255) stream.confirmations++;
+        stream.last_page = page;
+        match = &stream;
+        break;
+    }
+
+    if (match == nullptr) {
+        // Only misses start new streams; replace the least recently used one
+        if (!flash_miss) return;
+
+        Stream* victim = &streams[0];
+        for (auto& stream : streams) {
+            if (!stream.valid) {
+                victim = &stream;
+                break;
+            }
+            if (stream.last_use < victim->last_use) victim = &stream;
+        }
+        *victim = Stream{page, page, 0, 0, access_clock, true};
+        return;
+    }
+
+    match->last_use = access_clock;
+    if (match->direction == 0 || match->confirmations < CONFIRM_THRESHOLD) return;
+
+    // Keep the prefetch frontier `degree` pages ahead of the demand stream
+    int64_t lead = ((int64_t)match->next_prefetch - (int64_t)page) * match->direction;
+    if (lead <= 0) {
+        match->next_prefetch = page + match->direction;
+        lead = 1;
+    }
+    while (lead <= (int64_t)degree) {
+        candidates.push_back(match->next_prefetch);
+        if (match->direction < 0 && match->next_prefetch == 0) break;
+        match->next_prefetch += match->direction;
+        lead++;
+    }
+}
@@ -0,0 +1,155 @@
+#include "./../include/reuse_profiler.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+
+using namespace std;
+
+static const uint64_t HASH_RANGE = 1ULL << 24;
+static const uint64_t MIN_TREE_SIZE = 1ULL << 16;
+
+// splitmix64 finalizer: spreads block numbers uniformly for spatial sampling
+static uint64_t hashBlock(uint64_t block) {
+    block += 0x9E3779B97F4A7C15ULL;
+    block = (block ^ (block >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    block = (block ^ (block >> 27)) * 0x94D049BB133111EBULL;
+    return block ^ (block >> 31);
+}
+
+ReuseDistanceProfiler::ReuseDistanceProfiler(uint32_t block_size, double sampling_rate)
+    : block_size(max<uint32_t>(1, block_size)), clock(0), cold_misses(0),
+      total_accesses(0), sampled_accesses(0) {
+    if (sampling_rate <= 0.0 || sampling_rate > 1.0) sampling_rate = 1.0;
+    this->sampling_rate = sampling_rate;
+    sample_threshold = (uint64_t)(sampling_rate * HASH_RANGE);
+    tree.assign(MIN_TREE_SIZE + 1, 0);
+}
+
+void ReuseDistanceProfiler::access(uint64_t address) {
+    total_accesses++;
+
+    uint64_t block = address / block_size;
+    if (sampling_rate < 1.0 && (hashBlock(block) % HASH_RANGE) >= sample_threshold) return;
+    sampled_accesses++;
+
+    if (clock + 1 >= tree.size()) compact();
+    uint64_t now = ++clock;
+
+    auto previous = last_access.find(block);
+    if (previous == last_access.end()) {
+        cold_misses++;
+        last_access.emplace(block, now);
+    } else {
+        // Distinct blocks touched since the previous reference = marks after it
+        uint64_t distance = last_access.size() - prefix(previous->second);
+        if (distance >= histogram.size()) histogram.resize(distance + 1, 0);
+        histogram[distance]++;
+
+        mark(previous->second, -1);
+        previous->second = now;
+    }
+    mark(now, 1);
+}
+
+void ReuseDistanceProfiler::mark(uint64_t slot, int delta) {
+    for (; slot < tree.size(); slot += slot & (~slot + 1)) {
+        tree[slot] += delta;
+    }
+}
+
+uint64_t ReuseDistanceProfiler::prefix(uint64_t slot) const {
+    uint64_t sum = 0;
+    for (; slot > 0; slot -= slot & (~slot + 1)) {
+        sum += tree[slot];
+    }
+    return sum;
+}
+
+void ReuseDistanceProfiler::compact() {
+    // Renumber live timestamps 1..n in order and rebuild the tree with headroom
+    vector<pair<uint64_t, uint64_t>> live;
+    live.reserve(last_access.size());
+    for (const auto& entry : last_access) {
+        live.emplace_back(entry.second, entry.first);
+    }
+    sort(live.begin(), live.end());
+
+    uint64_t size = max<uint64_t>(MIN_TREE_SIZE, live.size() * 2);
+    tree.assign(size + 1, 0);
+    for (uint64_t i = 0; i < live.size(); i++) {
+        last_access[live[i].second] = i + 1;
+        tree[i + 1] = 1;
+    }
+    // Linear-time Fenwick construction from the 0/1 marks
+    for (uint64_t slot = 1; slot <= size; slot++) {
+        uint64_t parent = slot + (slot & (~slot + 1));
+        if (parent <= size) tree[parent] += tree[slot];
+    }
+    clock = live.size();
+}
+
+uint64_t ReuseDistanceProfiler::scaledBlocks(uint64_t sampled_distance) const {
+    return (uint64_t)(sampled_distance / sampling_rate);
+}
+
+double ReuseDistanceProfiler::missRatio(uint64_t cache_bytes) const {
+    if (sampled_accesses == 0) return 0.0;
+
+    // A reuse hits in an LRU cache of C blocks iff its stack distance is below C
+    uint64_t capacity = (uint64_t)((cache_bytes / block_size) * sampling_rate);
+    uint64_t misses = cold_misses;
+    for (uint64_t d = capacity; d < histogram.size(); d++) {
+        misses += histogram[d];
+    }
+    return (double)misses / sampled_accesses;
+}
+
+void ReuseDistanceProfiler::printCurve(uint64_t highlight_bytes) const {
+    cout << "\n=== Reuse-Distance Profile ===" << endl;
+    cout << "-----------------------------------" << endl;
+    cout << "Total Accesses:            " << total_accesses << endl;
+    cout << "Block Size:                " << block_size << " bytes" << endl;
+    if (sampling_rate < 1.0) {
+        cout << "Sampled Accesses:          " << sampled_accesses << " (SHARDS rate "
+             << fixed << setprecision(4) << sampling_rate << ")" << endl;
+    }
+    cout << "Distinct Blocks:           " << scaledBlocks(last_access.size())
+         << (sampling_rate < 1.0 ? " (estimated)" : "") << endl;
+    cout << "Cold Misses:               " << fixed << setprecision(2)
+         << (sampled_accesses > 0 ? (double)cold_misses / sampled_accesses * 100.0 : 0.0) << "%" << endl;
+
+    cout << "\n--- Miss-Ratio Curve (fully associative LRU) ---" << endl;
+    cout << "Cache Size (bytes)         Miss Ratio" << endl;
+
+    // Powers of two up to the footprint; the full step curve goes to the CSV
+    uint64_t footprint = scaledBlocks(last_access.size()) * block_size;
+    for (uint64_t size = block_size; ; size *= 2) {
+        cout << left << setw(27) << size << right << fixed << setprecision(2)
+             << missRatio(size) * 100.0 << "%" << endl;
+        if (size >= footprint) break;
+    }
+
+    if (highlight_bytes > 0) {
+        cout << "\nConfigured DRAM tier (" << highlight_bytes << " bytes): "
+             << fixed << setprecision(2) << missRatio(highlight_bytes) * 100.0 << "% misses" << endl;
+    }
+    cout << "-----------------------------------" << endl;
+}
+
+bool ReuseDistanceProfiler::writeCurve(const string& path) const {
+    ofstream out(path);
+    if (!out.is_open()) return false;
+
+    // One row per step of the curve: the miss ratio holds until the next size
+    out << "cache_blocks,cache_bytes,miss_ratio" << endl;
+    uint64_t misses = sampled_accesses;
+    for (uint64_t d = 0; d <= histogram.size(); d++) {
+        if (d > 0 && histogram[d - 1] == 0) continue;
+        if (d > 0) misses -= histogram[d - 1];
+        uint64_t blocks = scaledBlocks(d);
+        out << blocks << "," << blocks * block_size << ","
+            << (sampled_accesses > 0 ? (double)misses / sampled_accesses : 0.0) << endl;
+    }
+    return true;
+}
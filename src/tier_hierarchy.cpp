@@ -0,0 +1,227 @@
+#include "./../include/tier_hierarchy.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+TierHierarchy::TierHierarchy(const vector<TierConfig>& tier_configs, uint32_t page_size, uint32_t access_size,
+                             double promote_margin, uint32_t cooldown)
+    : page_size(page_size), access_size(access_size), promote_margin(promote_margin), cooldown(cooldown) {
+    for (size_t i = 0; i < tier_configs.size(); i++) {
+        Tier tier;
+        tier.config = tier_configs[i];
+        // The last tier backs the whole address space
+        bool backing_store = (i + 1 == tier_configs.size());
+        tier.capacity_pages = backing_store ? 0 : max<uint64_t>(1, tier.config.capacity / page_size);
+        tiers.push_back(tier);
+    }
+    reset();
+}
+
+void TierHierarchy::reset() {
+    pages.clear();
+    access_sequence = 0;
+    for (auto& tier : tiers) {
+        tier.busy_until = 0;
+        tier.order.clear();
+        tier.stats = TierStats{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    }
+}
+
+void TierHierarchy::resetStats() {
+    for (auto& tier : tiers) {
+        tier.stats = TierStats{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    }
+}
+
+uint32_t TierHierarchy::access(char operation, uint64_t address, uint64_t now) {
+    uint64_t page = address / page_size;
+    access_sequence++;
+
+    auto found = pages.find(page);
+    if (found == pages.end()) {
+        uint32_t tier_index = allocate(page);
+        found = pages.find(page);
+        tiers[tier_index].stats.allocations++;
+    }
+    PageInfo& info = found->second;
+    Tier& tier = tiers[info.tier];
+
+    // Queue behind whatever currently occupies the tier interface
+    uint64_t queue_delay = tier.busy_until > now ? tier.busy_until - now : 0;
+    occupy(tier, now, access_size);
+
+    uint32_t device_latency;
+    if (operation == 'W') {
+        tier.stats.writes++;
+        device_latency = tier.config.write_latency;
+    } else {
+        tier.stats.reads++;
+        device_latency = tier.config.read_latency;
+    }
+    uint32_t latency = queue_delay + device_latency + transferCycles(tier, access_size);
+
+    tier.stats.accesses++;
+    tier.stats.latency_cycles += latency;
+    tier.stats.queue_cycles += queue_delay;
+
+    if (tier.config.eviction == TierEviction::LRU) {
+        tier.order.splice(tier.order.end(), tier.order, info.position);
+    }
+
+    // Promote one level once the page has proven itself in this tier and is hotter
+    // than the page it would push out
+    info.access_count++;
+    if (info.tier > 0 && tier.config.promote_threshold > 0 &&
+        info.access_count >= tier.config.promote_threshold) {
+        if (canPromote(info, info.tier - 1)) {
+            migrate(page, info.tier - 1, now + latency);
+        } else {
+            tier.stats.promotions_blocked++;
+        }
+    }
+
+    return latency;
+}
+
+bool TierHierarchy::isFull(uint32_t tier) const {
+    const Tier& t = tiers[tier];
+    return t.capacity_pages > 0 && t.order.size() >= t.capacity_pages;
+}
+
+bool TierHierarchy::canPromote(const PageInfo& candidate, uint32_t to) {
+    if (access_sequence < candidate.pinned_until) return false;
+    if (!isFull(to)) return true;
+
+    PageInfo& victim = pages[tiers[to].order.front()];
+    if (access_sequence < victim.pinned_until) return false;
+    if (candidate.access_count > victim.access_count * (1.0 + promote_margin)) return true;
+
+    // A victim that keeps its slot ages, so a page that has gone cold cannot hold it forever
+    victim.access_count /= 2;
+    return false;
+}
+
+uint32_t TierHierarchy::allocate(uint64_t page) {
+    // Fastest first-touch tier with free space, otherwise the backing store
+    uint32_t target = tiers.size() - 1;
+    for (uint32_t i = 0; i + 1 < tiers.size(); i++) {
+        if (tiers[i].config.placement == TierPlacement::FIRST_TOUCH && !isFull(i)) {
+            target = i;
+            break;
+        }
+    }
+
+    PageInfo info;
+    info.pinned_until = 0;
+    place(page, target, info);
+    pages[page] = info;
+    return target;
+}
+
+void TierHierarchy::place(uint64_t page, uint32_t tier, PageInfo& info) {
+    info.tier = tier;
+    info.access_count = 0;
+    info.position = tiers[tier].order.insert(tiers[tier].order.end(), page);
+}
+
+void TierHierarchy::migrate(uint64_t page, uint32_t to, uint64_t now) {
+    PageInfo& info = pages[page];
+    uint32_t from = info.tier;
+    Tier& source = tiers[from];
+
+    source.order.erase(info.position);
+    if (isFull(to)) makeRoom(to, now);
+
+    // The copy occupies both tier interfaces for a full page transfer
+    occupy(source, now, page_size);
+    occupy(tiers[to], now, page_size);
+    source.stats.migrated_bytes += page_size;
+    tiers[to].stats.migrated_bytes += page_size;
+
+    if (to < from) {
+        source.stats.promotions_out++;
+        tiers[to].stats.promotions_in++;
+    } else {
+        source.stats.demotions_out++;
+        tiers[to].stats.demotions_in++;
+    }
+
+    place(page, to, info);
+    info.pinned_until = access_sequence + cooldown;
+}
+
+void TierHierarchy::makeRoom(uint32_t tier, uint64_t now) {
+    // Demote the victim one level; that may in turn push a page further down
+    uint64_t victim = tiers[tier].order.front();
+    migrate(victim, tier + 1, now);
+}
+
+uint64_t TierHierarchy::occupy(Tier& tier, uint64_t now, uint64_t bytes) {
+    tier.busy_until = max(tier.busy_until, now) + transferCycles(tier, bytes);
+    return tier.busy_until;
+}
+
+uint64_t TierHierarchy::transferCycles(const Tier& tier, uint64_t bytes) const {
+    if (tier.config.bandwidth == 0) return 0;
+    return (bytes + tier.config.bandwidth - 1) / tier.config.bandwidth;
+}
+
+void TierHierarchy::printSummary() const {
+    cout << "Tiered mode enabled: " << tiers.size() << " tiers, "
+         << page_size << "-byte pages, promotion margin " << promote_margin
+         << ", cooldown " << cooldown << " accesses" << endl;
+    for (size_t i = 0; i < tiers.size(); i++) {
+        const TierConfig& config = tiers[i].config;
+        cout << "  Tier " << i << " (" << config.name << "): ";
+        if (tiers[i].capacity_pages == 0) {
+            cout << "backing store";
+        } else {
+            cout << config.capacity << " bytes";
+        }
+        cout << ", R/W " << config.read_latency << "/" << config.write_latency << " cycles";
+        if (config.bandwidth > 0) {
+            cout << ", " << config.bandwidth << " B/cycle";
+        }
+        cout << endl;
+    }
+}
+
+void TierHierarchy::printStats(uint64_t total_accesses) const {
+    cout << "\n=== Tiered Memory Statistics (" << tiers.size() << " tiers) ===" << endl;
+    cout << "-----------------------------------" << endl;
+
+    for (size_t i = 0; i < tiers.size(); i++) {
+        const Tier& tier = tiers[i];
+        const TierStats& stats = tier.stats;
+
+        cout << "\n--- Tier " << i << ": " << tier.config.name << " ---" << endl;
+        if (tier.capacity_pages == 0) {
+            cout << "Capacity:                  backing store (" << tier.order.size()
+                 << " pages resident)" << endl;
+        } else {
+            cout << "Capacity:                  " << tier.config.capacity << " bytes ("
+                 << tier.order.size() << " / " << tier.capacity_pages << " pages resident)" << endl;
+        }
+        cout << "Accesses:                  " << stats.accesses
+             << " (reads: " << stats.reads << ", writes: " << stats.writes << ")" << endl;
+        if (total_accesses > 0) {
+            double share = (double)stats.accesses / total_accesses * 100.0;
+            cout << "Access Share:              " << fixed << setprecision(2) << share << "%" << endl;
+        }
+        if (stats.accesses > 0) {
+            double avg_latency = (double)stats.latency_cycles / stats.accesses;
+            cout << "Average Latency:           " << fixed << setprecision(2)
+                 << avg_latency << " cycles" << endl;
+        }
+        cout << "Queueing Delay:            " << stats.queue_cycles << " cycles" << endl;
+        cout << "First-Touch Allocations:   " << stats.allocations << endl;
+        cout << "Promotions In / Out:       " << stats.promotions_in << " / " << stats.promotions_out << endl;
+        cout << "Demotions In / Out:        " << stats.demotions_in << " / " << stats.demotions_out << endl;
+        if (i > 0) cout << "Promotions Blocked:        " << stats.promotions_blocked << endl;
+        cout << "Migrated Data:             " << stats.migrated_bytes << " bytes" << endl;
+    }
+
+    cout << "-----------------------------------" << endl;
+}
@@ -0,0 +1,26 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <iostream>
+
+// Minimal assertion helpers for the regression checks built by `make check`.
+// Each check is one program: it prints one line and exits non-zero on failure.
+static int check_failures = 0;
+
+#define CHECK_EQ(actual, expected)                                                      \
+    do {                                                                                \
+        auto actual_value = (actual);                                                   \
+        auto expected_value = static_cast<decltype(actual_value)>(expected);            \
+        if (!(actual_value == expected_value)) {                                        \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << #actual << " = "        \
+                      << actual_value << ", expected " << expected_value << std::endl;  \
+            check_failures++;                                                           \
+        }                                                                               \
+    } while (0)
+
+static int checkResult(const char* name) {
+    std::cout << name << (check_failures > 0 ? ": FAILED" : ": ok") << std::endl;
+    return check_failures > 0 ? 1 : 0;
+}
+
+#endif // TESTS_CHECK_H
@@ -0,0 +1,66 @@
+// Miss-ratio curve check: with sampling disabled the profiler's curve must
+// match a brute-force fully associative LRU cache exactly at every size.
+// The trace is long enough to force several timestamp compactions.
+#include "reuse_profiler.h"
+#include "check.h"
+
+#include <cmath>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+static const uint32_t BLOCK_SIZE = 64;
+
+// Misses of an LRU cache holding `capacity` blocks, simulated directly
+static uint64_t lruMisses(const vector<uint64_t>& addresses, uint64_t capacity) {
+    list<uint64_t> recency;     // Most recently used block at the front
+    unordered_map<uint64_t, list<uint64_t>::iterator> resident;
+    uint64_t misses = 0;
+
+    for (uint64_t address : addresses) {
+        uint64_t block = address / BLOCK_SIZE;
+        auto it = resident.find(block);
+        if (it != resident.end()) {
+            recency.splice(recency.begin(), recency, it->second);
+            continue;
+        }
+        misses++;
+        if (resident.size() == capacity) {
+            resident.erase(recency.back());
+            recency.pop_back();
+        }
+        recency.push_front(block);
+        resident[block] = recency.begin();
+    }
+    return misses;
+}
+
+int main() {
+    // Skewed trace: most references go to a small hot set, the rest spread
+    // over a larger footprint, with random offsets inside each block
+    vector<uint64_t> addresses;
+    uint64_t state = 12345;
+    for (int i = 0; i < 200000; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t value = state >> 33;
+        uint64_t block = (value % 4 == 0) ? (value >> 2) % 3000 : (value >> 2) % 200;
+        addresses.push_back(block * BLOCK_SIZE + (value >> 20) % BLOCK_SIZE);
+    }
+
+    ReuseDistanceProfiler profiler(BLOCK_SIZE, 1.0);
+    for (uint64_t address : addresses) {
+        profiler.access(address);
+    }
+    CHECK_EQ(profiler.totalAccesses(), addresses.size());
+    CHECK_EQ(profiler.sampledAccesses(), addresses.size());
+
+    for (uint64_t capacity : {1, 2, 16, 100, 199, 200, 201, 500, 1000, 2999, 3000, 4096}) {
+        uint64_t expected = lruMisses(addresses, capacity);
+        double ratio = profiler.missRatio(capacity * BLOCK_SIZE);
+        CHECK_EQ(llround(ratio * addresses.size()), expected);
+    }
+
+    return checkResult("miss-ratio curve");
+}
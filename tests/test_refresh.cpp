@@ -0,0 +1,53 @@
+// Refresh check: every bank is touched once per 1000 cycles for ten tREFI
+// (64000 cycles each), so each refresh command owed by then is issued
+// exactly once. The expected counts per tREFI follow from the refresh mode
+// and granularity, and each command's tRFC follows from the configured
+// refresh_latency (100) and the FGR scaling.
+#include "hybridmemsim.h"
+#include "check.h"
+
+using namespace std;
+
+static const uint32_t BANKS = 4;
+static const uint64_t TREFI = 64000;
+static const uint64_t INTERVALS = 10;
+
+static StatsSnapshot runRefresh(RefreshMode mode, uint32_t granularity) {
+    Config config;
+    read_config("tests/dram.cfg", &config);
+    config.quiet = true;
+    config.refresh_mode = mode;
+    config.refresh_granularity = granularity;
+
+    hybridmemsim::MemorySystem system(config);
+    uint64_t tag = 0;
+    for (uint64_t cycle = 500; cycle <= INTERVALS * TREFI + 500; cycle += 1000) {
+        for (uint64_t bank = 0; bank < BANKS; bank++) {
+            system.send(tag++, bank << 12, false, cycle);
+        }
+    }
+    system.tick(INTERVALS * TREFI + 2000);
+    return system.stats();
+}
+
+static void checkRefresh(RefreshMode mode, uint32_t granularity, uint64_t commands_per_trefi,
+                         uint64_t trfc, uint64_t banks_per_command) {
+    StatsSnapshot stats = runRefresh(mode, granularity);
+    CHECK_EQ(stats.refresh_commands, INTERVALS * commands_per_trefi);
+    CHECK_EQ(stats.refresh_cycles, INTERVALS * commands_per_trefi * trfc);
+    // Each refresh closes the rows it covers, so the access after it opens the row again
+    CHECK_EQ(stats.row_empty_misses, BANKS + INTERVALS * commands_per_trefi * banks_per_command);
+    CHECK_EQ(stats.row_conflict_misses, 0);
+    CHECK_EQ(stats.row_hits + stats.row_empty_misses, stats.total_accesses);
+}
+
+int main() {
+    checkRefresh(RefreshMode::ALL_BANK, 1, 1, 100, BANKS);
+    checkRefresh(RefreshMode::ALL_BANK, 2, 2, 74, BANKS);
+    checkRefresh(RefreshMode::ALL_BANK, 4, 4, 46, BANKS);
+    // Per-bank: one command per bank per tREFI, each half the all-bank tRFC
+    checkRefresh(RefreshMode::PER_BANK, 1, BANKS, 50, 1);
+    checkRefresh(RefreshMode::PER_BANK, 2, 2 * BANKS, 37, 1);
+
+    return checkResult("refresh");
+}
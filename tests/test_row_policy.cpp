@@ -0,0 +1,99 @@
+// Row-buffer policy check: short request sequences against one bank whose
+// row hits, empty-row misses and conflicts under each page policy are known
+// by hand. All requests finish before the first refresh is due.
+#include "hybridmemsim.h"
+#include "check.h"
+
+#include <map>
+#include <vector>
+
+using namespace std;
+
+// Address of column 0 of the given row in bank 0
+static uint64_t rowAddress(uint64_t row) {
+    return row << 2;
+}
+
+struct Step {
+    uint64_t row;
+    uint64_t issue_cycle;
+};
+
+static StatsSnapshot runSteps(PagePolicy policy, const vector<Step>& steps,
+                                            map<uint64_t, uint64_t>& latencies) {
+    Config config;
+    read_config("tests/dram.cfg", &config);
+    config.quiet = true;
+    config.page_policy = policy;
+
+    hybridmemsim::MemorySystem system(config);
+    system.setCompletionCallback([&latencies](const hybridmemsim::Completion& completion) {
+        latencies[completion.tag] = completion.complete_cycle - completion.issue_cycle;
+    });
+    for (size_t i = 0; i < steps.size(); i++) {
+        system.send(i, rowAddress(steps[i].row), false, steps[i].issue_cycle);
+    }
+    system.tick(steps.back().issue_cycle + 1000);
+    return system.stats();
+}
+
+int main() {
+    // Open page: the row stays open until another row needs the bank
+    {
+        map<uint64_t, uint64_t> latencies;
+        StatsSnapshot stats = runSteps(PagePolicy::OPEN,
+            {{1, 0}, {1, 100}, {2, 200}, {2, 300}, {1, 400}}, latencies);
+        CHECK_EQ(stats.total_accesses, 5);
+        CHECK_EQ(stats.row_hits, 2);
+        CHECK_EQ(stats.row_empty_misses, 1);
+        CHECK_EQ(stats.row_conflict_misses, 2);
+        CHECK_EQ(stats.row_misses, 3);
+        CHECK_EQ(latencies[0], 20);
+        CHECK_EQ(latencies[1], 10);
+        CHECK_EQ(latencies[2], 30);
+        CHECK_EQ(latencies[3], 10);
+        CHECK_EQ(latencies[4], 30);
+    }
+
+    // Closed page: every access finds the bank precharged
+    {
+        map<uint64_t, uint64_t> latencies;
+        StatsSnapshot stats = runSteps(PagePolicy::CLOSED,
+            {{1, 0}, {1, 100}, {2, 200}, {2, 300}, {1, 400}}, latencies);
+        CHECK_EQ(stats.row_hits, 0);
+        CHECK_EQ(stats.row_empty_misses, 5);
+        CHECK_EQ(stats.row_conflict_misses, 0);
+        for (uint64_t tag = 0; tag < 5; tag++) {
+            CHECK_EQ(latencies[tag], 20);
+        }
+    }
+
+    // Timeout (200 idle cycles): the row survives a short gap, not a long one
+    {
+        map<uint64_t, uint64_t> latencies;
+        StatsSnapshot stats = runSteps(PagePolicy::TIMEOUT,
+            {{1, 0}, {1, 100}, {1, 1000}, {2, 1100}}, latencies);
+        CHECK_EQ(stats.row_hits, 1);
+        CHECK_EQ(stats.row_empty_misses, 2);
+        CHECK_EQ(stats.row_conflict_misses, 1);
+        CHECK_EQ(latencies[0], 20);
+        CHECK_EQ(latencies[1], 10);
+        CHECK_EQ(latencies[2], 20);
+        CHECK_EQ(latencies[3], 30);
+    }
+
+    // Adaptive: starts open, closes after two rows that were never reused,
+    // then reopens once a closed row would have hit
+    {
+        map<uint64_t, uint64_t> latencies;
+        StatsSnapshot stats = runSteps(PagePolicy::ADAPTIVE,
+            {{1, 0}, {1, 100}, {2, 200}, {3, 300}, {4, 400}, {4, 500}, {4, 600}, {4, 700}},
+            latencies);
+        CHECK_EQ(stats.total_accesses, 8);
+        CHECK_EQ(stats.row_hits, 2);
+        CHECK_EQ(stats.row_empty_misses, 4);
+        CHECK_EQ(stats.row_conflict_misses, 2);
+    }
+
+    return checkResult("row policy");
+}